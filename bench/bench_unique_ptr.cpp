@@ -0,0 +1,728 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "atomic_unique.hpp"
+#include "batch.hpp"
+#include "deferred.hpp"
+#include "pool.hpp"
+#include "recycle.hpp"
+#include "relocate.hpp"
+#include "thread_cache.hpp"
+#include "unique.hpp"
+
+// Results are comparable only in optimised builds, e.g.
+//   cmake -S . -B build -DCMAKE_BUILD_TYPE=Release -DUNIQUE_PTR_BUILD_BENCHMARKS=ON
+//   cmake --build build --target bench_json
+// which writes build/bench_results.json.
+
+namespace
+{
+    constexpr std::size_t kArrayLength = 64;
+    constexpr std::size_t kDestroyBatch = 256;
+
+    template <std::size_t Bytes>
+    struct Payload
+    {
+        unsigned char m_bytes[Bytes];
+    };
+
+    // Deleter carrying state so it cannot be folded away by [[no_unique_address]]
+    template <typename T>
+    struct StatefulDeleter
+    {
+        std::uintptr_t m_tag = 0;
+
+        void operator()(T *p) const noexcept
+        {
+            delete p;
+        }
+    };
+
+    template <typename T>
+    struct StatefulDeleter<T[]>
+    {
+        std::uintptr_t m_tag = 0;
+
+        void operator()(T *p) const noexcept
+        {
+            delete[] p;
+        }
+    };
+
+    template <typename T>
+    std::remove_extent_t<T> *allocate()
+    {
+        if constexpr (std::is_array_v<T>)
+        {
+            return new std::remove_extent_t<T>[kArrayLength];
+        }
+        else
+        {
+            return new T();
+        }
+    }
+
+    template <typename T>
+    void deallocate(std::remove_extent_t<T> *p) noexcept
+    {
+        if constexpr (std::is_array_v<T>)
+        {
+            delete[] p;
+        }
+        else
+        {
+            delete p;
+        }
+    }
+
+    template <typename T>
+    std::string shapeName()
+    {
+        return std::is_array_v<T> ? "array" : "scalar";
+    }
+
+    // Owner policies: each exposes the same operations so one benchmark body
+    // covers UniquePtr, std::unique_ptr and a raw pointer baseline.
+    template <typename T, typename D>
+    struct CustomOwner
+    {
+        using Elem = std::remove_extent_t<T>;
+        using Ptr = UniquePtr<T, D>;
+
+        static std::string name() { return "UniquePtr"; }
+        static Ptr adopt(Elem *p) { return Ptr(p, D{}); }
+        static Elem *release(Ptr &p) noexcept { return p.release(); }
+        static void reset(Ptr &p, Elem *q) noexcept { p.reset(q); }
+        static void dispose(Ptr &) noexcept {}
+
+        static Ptr make()
+        {
+            if constexpr (std::is_array_v<T>)
+            {
+                return ::make_unique<Elem>(kArrayLength);
+            }
+            else
+            {
+                return ::make_unique<T>();
+            }
+        }
+    };
+
+    template <typename T, typename D>
+    struct StdOwner
+    {
+        using Elem = std::remove_extent_t<T>;
+        using Ptr = std::unique_ptr<T, D>;
+
+        static std::string name() { return "std::unique_ptr"; }
+        static Ptr adopt(Elem *p) { return Ptr(p, D{}); }
+        static Elem *release(Ptr &p) noexcept { return p.release(); }
+        static void reset(Ptr &p, Elem *q) noexcept { p.reset(q); }
+        static void dispose(Ptr &) noexcept {}
+
+        static Ptr make()
+        {
+            if constexpr (std::is_array_v<T>)
+            {
+                return std::make_unique<T>(kArrayLength);
+            }
+            else
+            {
+                return std::make_unique<T>();
+            }
+        }
+    };
+
+    template <typename T>
+    struct RawOwner
+    {
+        using Elem = std::remove_extent_t<T>;
+        using Ptr = Elem *;
+
+        static std::string name() { return "raw"; }
+        static Ptr adopt(Elem *p) noexcept { return p; }
+        static Elem *release(Ptr &p) noexcept { return std::exchange(p, nullptr); }
+
+        static void reset(Ptr &p, Elem *q) noexcept
+        {
+            deallocate<T>(std::exchange(p, q));
+        }
+
+        static void dispose(Ptr &p) noexcept
+        {
+            deallocate<T>(std::exchange(p, nullptr));
+        }
+
+        static Ptr make() { return allocate<T>(); }
+    };
+
+    template <typename T>
+    struct PooledOwner
+    {
+        using Ptr = UniquePtr<T, PoolDeleter<T>>;
+
+        static std::string name() { return "UniquePtr"; }
+        static void dispose(Ptr &) noexcept {}
+        static Ptr make() { return make_pooled_unique<T>(); }
+    };
+
+    template <typename T>
+    struct RecycledOwner
+    {
+        using Ptr = UniquePtr<T, RecyclingDeleter<T>>;
+
+        static std::string name() { return "UniquePtr"; }
+        static void dispose(Ptr &) noexcept {}
+        static Ptr make() { return make_recycled<T>(); }
+    };
+
+    template <typename T>
+    struct CachedOwner
+    {
+        using Ptr = UniquePtr<T, CachedDeleter<T>>;
+
+        static std::string name() { return "UniquePtr"; }
+        static void dispose(Ptr &) noexcept {}
+        static Ptr make() { return make_unique_cached<T>(); }
+    };
+
+    // Full lifetime: allocate, take ownership, destroy
+    template <typename T, typename Owner>
+    void BM_Construct(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            typename Owner::Ptr p = Owner::adopt(allocate<T>());
+            benchmark::DoNotOptimize(p);
+            Owner::dispose(p);
+        }
+    }
+
+    template <typename T, typename Owner>
+    void BM_MakeUnique(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            typename Owner::Ptr p = Owner::make();
+            benchmark::DoNotOptimize(p);
+            Owner::dispose(p);
+        }
+    }
+
+    // Move-construct back and forth between two slots, destroying the moved-from owner
+    template <typename T, typename Owner>
+    void BM_MoveConstruct(benchmark::State &state)
+    {
+        using Ptr = typename Owner::Ptr;
+
+        alignas(Ptr) unsigned char slots[2][sizeof(Ptr)];
+        Ptr *from = std::construct_at(reinterpret_cast<Ptr *>(slots[0]), Owner::adopt(allocate<T>()));
+        Ptr *to = reinterpret_cast<Ptr *>(slots[1]);
+
+        for (auto _ : state)
+        {
+            std::construct_at(to, std::move(*from));
+            std::destroy_at(from);
+            benchmark::DoNotOptimize(*to);
+            std::swap(from, to);
+        }
+
+        Owner::dispose(*from);
+        std::destroy_at(from);
+    }
+
+    template <typename T, typename Owner>
+    void BM_MoveAssign(benchmark::State &state)
+    {
+        typename Owner::Ptr a = Owner::adopt(allocate<T>());
+        typename Owner::Ptr b = Owner::adopt(nullptr);
+
+        for (auto _ : state)
+        {
+            b = std::move(a);
+            benchmark::DoNotOptimize(b);
+            a = std::move(b);
+            benchmark::DoNotOptimize(a);
+        }
+
+        Owner::dispose(a);
+    }
+
+    // Replaces the owned object, so includes one allocation and one free
+    template <typename T, typename Owner>
+    void BM_Reset(benchmark::State &state)
+    {
+        typename Owner::Ptr p = Owner::adopt(allocate<T>());
+
+        for (auto _ : state)
+        {
+            Owner::reset(p, allocate<T>());
+            benchmark::DoNotOptimize(p);
+        }
+
+        Owner::dispose(p);
+    }
+
+    template <typename T, typename Owner>
+    void BM_Release(benchmark::State &state)
+    {
+        typename Owner::Ptr p = Owner::adopt(allocate<T>());
+
+        for (auto _ : state)
+        {
+            auto *raw = Owner::release(p);
+            benchmark::DoNotOptimize(raw);
+            Owner::reset(p, raw);
+        }
+
+        Owner::dispose(p);
+    }
+
+    template <typename T, typename Owner>
+    void BM_Swap(benchmark::State &state)
+    {
+        typename Owner::Ptr a = Owner::adopt(allocate<T>());
+        typename Owner::Ptr b = Owner::adopt(allocate<T>());
+
+        for (auto _ : state)
+        {
+            using std::swap;
+            swap(a, b);
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(b);
+        }
+
+        Owner::dispose(a);
+        Owner::dispose(b);
+    }
+
+    // Only the destruction of a batch of owners is timed
+    template <typename T, typename Owner>
+    void BM_Destroy(benchmark::State &state)
+    {
+        std::vector<typename Owner::Ptr> batch;
+        batch.reserve(kDestroyBatch);
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (std::size_t i = 0; i < kDestroyBatch; ++i)
+            {
+                batch.push_back(Owner::adopt(allocate<T>()));
+            }
+            state.ResumeTiming();
+
+            for (auto &p : batch)
+            {
+                Owner::dispose(p);
+            }
+            batch.clear();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kDestroyBatch));
+    }
+
+    // Allocating an I/O buffer and filling it once, as a socket read would
+    void BM_BufferForOverwrite(benchmark::State &state)
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            auto buffer = make_unique_for_overwrite<unsigned char[]>(size);
+            std::memset(buffer.get(), 0xAB, size);
+            benchmark::DoNotOptimize(buffer.get());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    }
+
+    void BM_BufferValueInit(benchmark::State &state)
+    {
+        const auto size = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            auto buffer = std::make_unique<unsigned char[]>(size);
+            std::memset(buffer.get(), 0xAB, size);
+            benchmark::DoNotOptimize(buffer.get());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    }
+
+    struct Handler
+    {
+        virtual ~Handler() = default;
+        virtual int handle() const noexcept = 0;
+    };
+
+    struct SmallHandler final : Handler
+    {
+        int m_value;
+        explicit SmallHandler(int value) noexcept : m_value(value) {}
+        int handle() const noexcept override { return m_value; }
+    };
+
+    // Create, call and destroy a small polymorphic handler
+    void BM_HandlerHeap(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            UniquePtr<Handler> p(new SmallHandler(1));
+            benchmark::DoNotOptimize(p->handle());
+        }
+    }
+
+    void BM_HandlerInline(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto p = make_inline_unique<Handler, SmallHandler>(1);
+            benchmark::DoNotOptimize(p->handle());
+        }
+    }
+
+    // Build n owners, walk them once, then drop them all
+    void BM_BuildOwnersSeparate(benchmark::State &state)
+    {
+        const auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            std::vector<UniquePtr<Payload<64>>> owners;
+            owners.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                owners.push_back(make_unique<Payload<64>>());
+            }
+            for (const auto &owner : owners)
+            {
+                benchmark::DoNotOptimize(owner->m_bytes[0]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    void BM_BuildOwnersBatch(benchmark::State &state)
+    {
+        const auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            auto owners = make_unique_batch<Payload<64>>(count);
+            for (const auto &owner : owners)
+            {
+                benchmark::DoNotOptimize(owner->m_bytes[0]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    struct OtherHandler final : Handler
+    {
+        int handle() const noexcept override { return 2; }
+    };
+
+    // Heterogeneous handler list owned by UniquePtr<Handler> (filled through
+    // converting moves) or by raw pointers. Building, dispatching and tearing
+    // down should cost the same for both.
+    struct RawHandlers
+    {
+        std::vector<Handler *> m_handlers;
+
+        ~RawHandlers()
+        {
+            for (Handler *h : m_handlers)
+            {
+                delete h;
+            }
+        }
+
+        void add(int i)
+        {
+            if (i % 2 == 0)
+            {
+                m_handlers.push_back(new SmallHandler(i));
+            }
+            else
+            {
+                m_handlers.push_back(new OtherHandler());
+            }
+        }
+    };
+
+    struct OwnedHandlers
+    {
+        std::vector<UniquePtr<Handler>> m_handlers;
+
+        void add(int i)
+        {
+            if (i % 2 == 0)
+            {
+                m_handlers.push_back(make_unique<SmallHandler>(i));
+            }
+            else
+            {
+                m_handlers.push_back(make_unique<OtherHandler>());
+            }
+        }
+    };
+
+    template <typename Handlers>
+    void BM_HandlerDispatch(benchmark::State &state)
+    {
+        const auto count = static_cast<int>(state.range(0));
+        Handlers handlers;
+        for (int i = 0; i < count; ++i)
+        {
+            handlers.add(i);
+        }
+
+        for (auto _ : state)
+        {
+            int total = 0;
+            for (const auto &h : handlers.m_handlers)
+            {
+                total += h->handle();
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    template <typename Handlers>
+    void BM_HandlerBuild(benchmark::State &state)
+    {
+        const auto count = static_cast<int>(state.range(0));
+        for (auto _ : state)
+        {
+            Handlers handlers;
+            handlers.m_handlers.reserve(static_cast<std::size_t>(count));
+            for (int i = 0; i < count; ++i)
+            {
+                handlers.add(i);
+            }
+            benchmark::DoNotOptimize(handlers.m_handlers.data());
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    // Growth of a pointer vector from empty, so every reallocation is measured
+    template <typename Vector>
+    void BM_VectorGrowth(benchmark::State &state)
+    {
+        const auto count = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            Vector v;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                v.emplace_back(nullptr);
+            }
+            benchmark::DoNotOptimize(v.data());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+    }
+
+    // Uncontended ownership handoff through a shared slot
+    void BM_HandoffMutex(benchmark::State &state)
+    {
+        std::mutex mutex;
+        UniquePtr<int> slot(new int(0));
+        UniquePtr<int> local(new int(1));
+
+        for (auto _ : state)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                swap(slot, local);
+            }
+            benchmark::DoNotOptimize(local.get());
+        }
+    }
+
+    void BM_HandoffAtomic(benchmark::State &state)
+    {
+        AtomicUniquePtr<int> slot(make_unique<int>(0));
+        UniquePtr<int> local(new int(1));
+
+        for (auto _ : state)
+        {
+            local = slot.exchange(std::move(local));
+            benchmark::DoNotOptimize(local.get());
+        }
+    }
+
+    template <typename T, typename Owner>
+    std::string benchmarkSuffix(const std::string &deleter)
+    {
+        return "/" + Owner::name() + "/" + deleter + "/" + shapeName<T>() + "/" +
+               std::to_string(sizeof(std::remove_extent_t<T>));
+    }
+
+    // Critical-path cost of dropping owners whose frees are deferred;
+    // the actual reclamation happens outside the timed region
+    template <typename T>
+    void BM_DestroyDeferred(benchmark::State &state)
+    {
+        std::vector<UniquePtr<T, DeferredDeleter<T>>> batch;
+        batch.reserve(kDestroyBatch);
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            reclaim_deferred();
+            for (std::size_t i = 0; i < kDestroyBatch; ++i)
+            {
+                batch.emplace_back(new T());
+            }
+            state.ResumeTiming();
+
+            batch.clear();
+        }
+
+        reclaim_deferred();
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kDestroyBatch));
+    }
+
+    // Free cost alone, with and without the size passed to operator delete.
+    // Only allocators with size classes (jemalloc, tcmalloc, mimalloc) can
+    // benefit from the size; glibc malloc ignores it.
+    template <typename T, bool Sized>
+    void BM_FreeSmall(benchmark::State &state)
+    {
+        std::vector<T *> batch(kDestroyBatch);
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (T *&p : batch)
+            {
+                p = new T();
+            }
+            state.ResumeTiming();
+
+            for (T *p : batch)
+            {
+                if constexpr (Sized)
+                {
+                    DefaultDeleter<T>()(p);
+                }
+                else
+                {
+                    p->~T();
+                    ::operator delete(static_cast<void *>(p));
+                }
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kDestroyBatch));
+    }
+
+    template <typename T, typename Owner, bool WithMake>
+    void registerOwner(const std::string &deleter)
+    {
+        const std::string suffix = benchmarkSuffix<T, Owner>(deleter);
+
+        benchmark::RegisterBenchmark(("Construct" + suffix).c_str(), BM_Construct<T, Owner>);
+        benchmark::RegisterBenchmark(("MoveConstruct" + suffix).c_str(), BM_MoveConstruct<T, Owner>);
+        benchmark::RegisterBenchmark(("MoveAssign" + suffix).c_str(), BM_MoveAssign<T, Owner>);
+        benchmark::RegisterBenchmark(("Reset" + suffix).c_str(), BM_Reset<T, Owner>);
+        benchmark::RegisterBenchmark(("Release" + suffix).c_str(), BM_Release<T, Owner>);
+        benchmark::RegisterBenchmark(("Swap" + suffix).c_str(), BM_Swap<T, Owner>);
+        benchmark::RegisterBenchmark(("Destroy" + suffix).c_str(), BM_Destroy<T, Owner>);
+
+        if constexpr (WithMake)
+        {
+            benchmark::RegisterBenchmark(("MakeUnique" + suffix).c_str(), BM_MakeUnique<T, Owner>);
+        }
+    }
+
+    template <typename T>
+    void registerShape()
+    {
+        registerOwner<T, CustomOwner<T, DefaultDeleter<T>>, true>("stateless");
+        registerOwner<T, StdOwner<T, std::default_delete<T>>, true>("stateless");
+        registerOwner<T, RawOwner<T>, true>("none");
+        registerOwner<T, CustomOwner<T, StatefulDeleter<T>>, false>("stateful");
+        registerOwner<T, StdOwner<T, StatefulDeleter<T>>, false>("stateful");
+
+        if constexpr (!std::is_array_v<T>)
+        {
+            benchmark::RegisterBenchmark(("MakeUnique" + benchmarkSuffix<T, PooledOwner<T>>("pooled")).c_str(),
+                                         BM_MakeUnique<T, PooledOwner<T>>);
+            benchmark::RegisterBenchmark(("MakeUnique" + benchmarkSuffix<T, RecycledOwner<T>>("recycled")).c_str(),
+                                         BM_MakeUnique<T, RecycledOwner<T>>);
+            benchmark::RegisterBenchmark(("MakeUnique" + benchmarkSuffix<T, CachedOwner<T>>("cached")).c_str(),
+                                         BM_MakeUnique<T, CachedOwner<T>>);
+            benchmark::RegisterBenchmark(("Destroy/UniquePtr/deferred/scalar/" + std::to_string(sizeof(T))).c_str(),
+                                         BM_DestroyDeferred<T>);
+            benchmark::RegisterBenchmark(("Free/operator delete/unsized/" + std::to_string(sizeof(T))).c_str(),
+                                         BM_FreeSmall<T, false>);
+            benchmark::RegisterBenchmark(("Free/operator delete/sized/" + std::to_string(sizeof(T))).c_str(),
+                                         BM_FreeSmall<T, true>);
+        }
+    }
+
+    // The same allocation on every thread at once: per-thread caches should scale, the global heap may not
+    template <typename T, typename Owner>
+    void registerThreaded(const std::string &deleter)
+    {
+        const int threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        benchmark::RegisterBenchmark(("MakeUniqueThreaded" + benchmarkSuffix<T, Owner>(deleter)).c_str(),
+                                     BM_MakeUnique<T, Owner>)
+            ->Threads(1)
+            ->Threads(threads)
+            ->UseRealTime();
+    }
+
+    template <std::size_t... Sizes>
+    void registerPayloads()
+    {
+        (registerShape<Payload<Sizes>>(), ...);
+        (registerShape<Payload<Sizes>[]>(), ...);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    registerPayloads<8, 64, 1024>();
+
+    registerThreaded<Payload<64>, CustomOwner<Payload<64>, DefaultDeleter<Payload<64>>>>("stateless");
+    registerThreaded<Payload<64>, CachedOwner<Payload<64>>>("cached");
+
+    benchmark::RegisterBenchmark("Buffer/UniquePtr/for_overwrite", BM_BufferForOverwrite)->Range(4 << 10, 4 << 20);
+    benchmark::RegisterBenchmark("Buffer/std::unique_ptr/value_init", BM_BufferValueInit)->Range(4 << 10, 4 << 20);
+
+    benchmark::RegisterBenchmark("VectorGrowth/std::vector", BM_VectorGrowth<std::vector<UniquePtr<int>>>)
+        ->Range(1 << 10, 1 << 20);
+    benchmark::RegisterBenchmark("VectorGrowth/RelocatingVector", BM_VectorGrowth<RelocatingVector<UniquePtr<int>>>)
+        ->Range(1 << 10, 1 << 20);
+
+    benchmark::RegisterBenchmark("Handoff/UniquePtr/mutex", BM_HandoffMutex);
+    benchmark::RegisterBenchmark("Handoff/AtomicUniquePtr/exchange", BM_HandoffAtomic);
+
+    benchmark::RegisterBenchmark("Handler/UniquePtr/heap", BM_HandlerHeap);
+    benchmark::RegisterBenchmark("Handler/InlineUniquePtr/inline", BM_HandlerInline);
+    benchmark::RegisterBenchmark("BuildOwners/make_unique", BM_BuildOwnersSeparate)->Arg(1024);
+    benchmark::RegisterBenchmark("BuildOwners/make_unique_batch", BM_BuildOwnersBatch)->Arg(1024);
+    benchmark::RegisterBenchmark("HandlerDispatch/raw", BM_HandlerDispatch<RawHandlers>)->Arg(1024);
+    benchmark::RegisterBenchmark("HandlerDispatch/UniquePtr<Base>", BM_HandlerDispatch<OwnedHandlers>)->Arg(1024);
+    benchmark::RegisterBenchmark("HandlerBuild/raw", BM_HandlerBuild<RawHandlers>)->Arg(1024);
+    benchmark::RegisterBenchmark("HandlerBuild/UniquePtr<Base>", BM_HandlerBuild<OwnedHandlers>)->Arg(1024);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
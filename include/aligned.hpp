@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "unique.hpp"
+
+// Transparent huge page size on x86-64 and AArch64 Linux
+inline constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+enum class PageHint
+{
+    Default,
+    // Buffers of at least kHugePageSize are 2 MB aligned and advised for
+    // transparent huge pages; smaller buffers ignore the hint
+    Huge
+};
+
+// Only defined for arrays, the one form make_unique_aligned produces
+template <typename T>
+struct AlignedDeleter;
+
+// Storage comes from std::aligned_alloc, so std::free releases it whatever the alignment
+template <typename T>
+struct AlignedDeleter<T[]>
+{
+    void operator()(T *m_ptr) const noexcept
+    {
+        std::free(m_ptr);
+    }
+};
+
+// Elements are default-initialised like make_unique(size_t).
+// Only trivially destructible element types are accepted, which keeps the deleter stateless.
+template <typename T>
+    requires std::is_unbounded_array_v<T>
+UniquePtr<T, AlignedDeleter<T>> make_unique_aligned(size_t size, size_t alignment, PageHint hint = PageHint::Default)
+{
+    using Elem = std::remove_extent_t<T>;
+    static_assert(std::is_trivially_destructible_v<Elem>, "make_unique_aligned requires trivially destructible elements");
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw std::invalid_argument("make_unique_aligned: alignment must be a power of two");
+    }
+    if (alignment < alignof(Elem))
+    {
+        alignment = alignof(Elem);
+    }
+
+    if (size > static_cast<size_t>(-1) / sizeof(Elem))
+    {
+        throw std::bad_array_new_length();
+    }
+
+    size_t bytes = size * sizeof(Elem);
+    const bool huge = hint == PageHint::Huge && bytes >= kHugePageSize;
+    if (huge && alignment < kHugePageSize)
+    {
+        alignment = kHugePageSize;
+    }
+
+    // aligned_alloc requires a non-zero multiple of the alignment
+    bytes = bytes == 0 ? alignment : (bytes + alignment - 1) & ~(alignment - 1);
+
+    void *storage = std::aligned_alloc(alignment, bytes);
+    if (!storage)
+    {
+        throw std::bad_alloc();
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge)
+    {
+        // Advisory only: without THP support the buffer simply uses normal pages
+        ::madvise(storage, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    Elem *elements = static_cast<Elem *>(storage);
+    std::uninitialized_default_construct_n(elements, size);
+    return UniquePtr<T, AlignedDeleter<T>>(elements);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "unique.hpp"
+
+namespace detail
+{
+    // std::pmr::polymorphic_allocator cannot be assigned, so rebuild it in place instead
+    template <typename Alloc>
+    void assignAllocator(Alloc &to, const Alloc &from) noexcept
+    {
+        if constexpr (std::is_copy_assignable_v<Alloc>)
+        {
+            to = from;
+        }
+        else if (&to != &from)
+        {
+            std::destroy_at(&to);
+            std::construct_at(&to, from);
+        }
+    }
+}
+
+// Destroys and deallocates one object through the allocator that created it.
+// Allocators whose pointer type is not a raw pointer are not supported.
+template <typename Alloc>
+struct AllocatorDeleter
+{
+    using Traits = std::allocator_traits<Alloc>;
+    using value_type = typename Traits::value_type;
+
+    static_assert(std::is_same_v<typename Traits::pointer, value_type *>,
+                  "AllocatorDeleter requires an allocator with raw pointers");
+
+    [[no_unique_address]] Alloc m_alloc;
+
+    AllocatorDeleter() = default;
+    explicit AllocatorDeleter(const Alloc &alloc) noexcept : m_alloc(alloc) {}
+    AllocatorDeleter(const AllocatorDeleter &) = default;
+
+    // Owners move-assign and swap their deleters
+    AllocatorDeleter &operator=(const AllocatorDeleter &other) noexcept
+    {
+        detail::assignAllocator(m_alloc, other.m_alloc);
+        return *this;
+    }
+
+    void operator()(value_type *m_ptr) noexcept
+    {
+        Traits::destroy(m_alloc, m_ptr);
+        Traits::deallocate(m_alloc, m_ptr, 1);
+    }
+};
+
+// Array form: deallocate() needs the element count back, so the deleter carries it
+template <typename Alloc>
+struct ArrayAllocatorDeleter
+{
+    using Traits = std::allocator_traits<Alloc>;
+    using value_type = typename Traits::value_type;
+
+    static_assert(std::is_same_v<typename Traits::pointer, value_type *>,
+                  "ArrayAllocatorDeleter requires an allocator with raw pointers");
+
+    [[no_unique_address]] Alloc m_alloc;
+    std::size_t m_count = 0;
+
+    ArrayAllocatorDeleter() = default;
+    ArrayAllocatorDeleter(const Alloc &alloc, std::size_t count) noexcept : m_alloc(alloc), m_count(count) {}
+    ArrayAllocatorDeleter(const ArrayAllocatorDeleter &) = default;
+
+    ArrayAllocatorDeleter &operator=(const ArrayAllocatorDeleter &other) noexcept
+    {
+        detail::assignAllocator(m_alloc, other.m_alloc);
+        m_count = other.m_count;
+        return *this;
+    }
+
+    void operator()(value_type *m_ptr) noexcept
+    {
+        for (std::size_t i = m_count; i > 0; --i)
+        {
+            Traits::destroy(m_alloc, m_ptr + i - 1);
+        }
+        Traits::deallocate(m_alloc, m_ptr, m_count);
+    }
+};
+
+// The allocator is rebound to T, so any allocator of the same family works
+template <typename T, typename Alloc, typename... Args>
+    requires(!std::is_array_v<T>)
+UniquePtr<T, AllocatorDeleter<typename std::allocator_traits<Alloc>::template rebind_alloc<T>>>
+allocate_unique(const Alloc &alloc, Args &&...args)
+{
+    using Rebound = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using Traits = std::allocator_traits<Rebound>;
+
+    Rebound rebound(alloc);
+    T *p = Traits::allocate(rebound, 1);
+
+    try
+    {
+        Traits::construct(rebound, p, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        Traits::deallocate(rebound, p, 1);
+        throw;
+    }
+
+    return UniquePtr<T, AllocatorDeleter<Rebound>>(p, AllocatorDeleter<Rebound>(rebound));
+}
+
+// Elements are value-initialised through allocator_traits::construct, so
+// allocator-aware elements (e.g. std::pmr::string) receive the allocator too
+template <typename T, typename Alloc>
+    requires std::is_unbounded_array_v<T>
+UniquePtr<T, ArrayAllocatorDeleter<typename std::allocator_traits<Alloc>::template rebind_alloc<std::remove_extent_t<T>>>>
+allocate_unique(const Alloc &alloc, size_t size)
+{
+    using Elem = std::remove_extent_t<T>;
+    using Rebound = typename std::allocator_traits<Alloc>::template rebind_alloc<Elem>;
+    using Traits = std::allocator_traits<Rebound>;
+
+    if (size > Traits::max_size(Rebound(alloc)))
+    {
+        throw std::bad_array_new_length();
+    }
+
+    Rebound rebound(alloc);
+    Elem *p = Traits::allocate(rebound, size);
+
+    std::size_t constructed = 0;
+    try
+    {
+        for (; constructed < size; ++constructed)
+        {
+            Traits::construct(rebound, p + constructed);
+        }
+    }
+    catch (...)
+    {
+        while (constructed > 0)
+        {
+            Traits::destroy(rebound, p + --constructed);
+        }
+        Traits::deallocate(rebound, p, size);
+        throw;
+    }
+
+    return UniquePtr<T, ArrayAllocatorDeleter<Rebound>>(p, ArrayAllocatorDeleter<Rebound>(rebound, size));
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "unique.hpp"
+
+// Monotonic allocator: allocation bumps a cursor, memory is reclaimed only
+// by reset() or destruction. Not thread-safe.
+class Arena
+{
+private:
+    struct Block
+    {
+        Block *m_prev;
+        std::size_t m_size;
+    };
+
+    static constexpr std::size_t kHeaderSize =
+        (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    Block *m_head = nullptr;
+    std::byte *m_cursor = nullptr;
+    std::byte *m_end = nullptr;
+    std::size_t m_blockSize;
+
+private:
+    static std::byte *data(Block *block) noexcept
+    {
+        return reinterpret_cast<std::byte *>(block) + kHeaderSize;
+    }
+
+    void pushBlock(std::size_t size)
+    {
+        Block *block = static_cast<Block *>(::operator new(kHeaderSize + size));
+        block->m_prev = m_head;
+        block->m_size = size;
+
+        m_head = block;
+        m_cursor = data(block);
+        m_end = m_cursor + size;
+    }
+
+    static std::byte *alignUp(std::byte *p, std::size_t alignment) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    }
+
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024) : m_blockSize(blockSize)
+    {
+    }
+
+    ~Arena()
+    {
+        while (m_head)
+        {
+            ::operator delete(std::exchange(m_head, m_head->m_prev));
+        }
+    }
+
+    // Not copyable - objects handed out point into our blocks
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Returns uninitialised storage, valid until the next reset()
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        std::byte *p = m_cursor ? alignUp(m_cursor, alignment) : nullptr;
+
+        if (!p || p + bytes > m_end)
+        {
+            // Oversized requests get a dedicated block
+            const std::size_t needed = bytes + alignment - 1;
+            pushBlock(needed > m_blockSize ? needed : m_blockSize);
+            p = alignUp(m_cursor, alignment);
+        }
+
+        m_cursor = p + bytes;
+        return p;
+    }
+
+    // Reclaims everything at once, keeping the newest block for reuse.
+    // Every object allocated from the arena must already be destroyed.
+    void reset() noexcept
+    {
+        if (!m_head)
+        {
+            return;
+        }
+
+        while (m_head->m_prev)
+        {
+            Block *prev = m_head->m_prev;
+            ::operator delete(std::exchange(m_head->m_prev, prev->m_prev));
+        }
+
+        m_cursor = data(m_head);
+        m_end = m_cursor + m_head->m_size;
+    }
+
+    [[nodiscard]] std::size_t bytesReserved() const noexcept
+    {
+        std::size_t total = 0;
+        for (const Block *block = m_head; block; block = block->m_prev)
+        {
+            total += block->m_size;
+        }
+        return total;
+    }
+};
+
+// Runs only the destructor - the memory belongs to the arena
+struct ArenaDeleter
+{
+    template <typename T>
+    void operator()(T *m_ptr) const noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            m_ptr->~T();
+        }
+    }
+};
+
+template <typename T, typename... Args>
+UniquePtr<T, ArenaDeleter> make_unique_in(Arena &arena, Args &&...args)
+{
+    void *storage = arena.allocate(sizeof(T), alignof(T));
+    return UniquePtr<T, ArenaDeleter>(new (storage) T(std::forward<Args>(args)...));
+}
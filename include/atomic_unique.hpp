@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "unique.hpp"
+
+// Single-slot owner whose pointer can be handed between threads without a lock.
+// Every transfer is one atomic instruction on the pointer; objects displaced by
+// store() or a successful compare_exchange() go through the Deleter.
+// Only the slot's own deleter is used: deleter state carried by incoming
+// UniquePtrs is dropped, so stateful deleters should all be equivalent.
+template <typename T, typename Deleter = DefaultDeleter<T>>
+class AtomicUniquePtr
+{
+    static_assert(std::atomic<T *>::is_always_lock_free, "AtomicUniquePtr requires lock-free pointer atomics");
+
+private:
+    std::atomic<T *> m_ptr;
+    [[no_unique_address]] Deleter m_deleter;
+
+private:
+    UniquePtr<T, Deleter> adopt(T *p) const
+    {
+        return UniquePtr<T, Deleter>(p, m_deleter);
+    }
+
+    void destroy(T *p) const noexcept
+    {
+        if (p)
+        {
+            m_deleter(p);
+        }
+    }
+
+public:
+    static constexpr bool is_always_lock_free = true;
+
+    AtomicUniquePtr() noexcept : m_ptr(nullptr), m_deleter() {}
+
+    explicit AtomicUniquePtr(UniquePtr<T, Deleter> p) noexcept : m_ptr(nullptr), m_deleter(p.getDeleter())
+    {
+        m_ptr.store(p.release(), std::memory_order_relaxed);
+    }
+
+    explicit AtomicUniquePtr(const Deleter &d) noexcept : m_ptr(nullptr), m_deleter(d) {}
+
+    ~AtomicUniquePtr()
+    {
+        destroy(m_ptr.load(std::memory_order_acquire));
+    }
+
+    // Neither copyable nor movable - threads refer to the slot by address
+    AtomicUniquePtr(const AtomicUniquePtr &) = delete;
+    AtomicUniquePtr &operator=(const AtomicUniquePtr &) = delete;
+
+public:
+    // Non-owning snapshot; the object may be displaced and deleted at any time
+    // unless the Deleter defers reclamation
+    [[nodiscard]] T *load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return m_ptr.load(order);
+    }
+
+    [[nodiscard]] Deleter &getDeleter() noexcept { return m_deleter; }
+    [[nodiscard]] const Deleter &getDeleter() const noexcept { return m_deleter; }
+
+    // Install desired and hand the previous object to the caller
+    [[nodiscard]] UniquePtr<T, Deleter> exchange(UniquePtr<T, Deleter> desired,
+                                                 std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return adopt(m_ptr.exchange(desired.release(), order));
+    }
+
+    // Install desired and delete the previous object
+    void store(UniquePtr<T, Deleter> desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        destroy(m_ptr.exchange(desired.release(), order));
+    }
+
+    // Take ownership of the current object, leaving the slot empty
+    [[nodiscard]] UniquePtr<T, Deleter> take(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return adopt(m_ptr.exchange(nullptr, order));
+    }
+
+    // If the slot holds expected, install desired and delete expected.
+    // Otherwise expected is updated to the current pointer and desired keeps its object.
+    bool compare_exchange(T *&expected, UniquePtr<T, Deleter> &desired,
+                          std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        if (!m_ptr.compare_exchange_strong(expected, desired.get(), order))
+        {
+            return false;
+        }
+
+        (void)desired.release();
+        destroy(expected);
+        return true;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return load() != nullptr;
+    }
+};
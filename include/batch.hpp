@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "unique.hpp"
+
+// One allocation holding a header followed by n objects. Each object's owner
+// holds one reference; the last one to be destroyed frees the whole slab,
+// on whichever thread that happens.
+class Slab
+{
+private:
+    std::atomic<std::size_t> m_refs;
+    std::size_t m_bytes;
+    std::align_val_t m_align;
+
+    Slab(std::size_t refs, std::size_t bytes, std::align_val_t align) noexcept
+        : m_refs(refs), m_bytes(bytes), m_align(align)
+    {
+    }
+
+public:
+    // Header size rounded up so the first object is suitably aligned
+    template <typename T>
+    static constexpr std::size_t headerSize() noexcept
+    {
+        return (sizeof(Slab) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    Slab(const Slab &) = delete;
+    Slab &operator=(const Slab &) = delete;
+
+    // Storage for n objects of T, with n references
+    template <typename T>
+    static Slab *create(std::size_t n)
+    {
+        if (n > (static_cast<std::size_t>(-1) - headerSize<T>()) / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        const std::size_t bytes = headerSize<T>() + n * sizeof(T);
+        const std::align_val_t align{std::max(alignof(T), alignof(Slab))};
+        return new (::operator new(bytes, align)) Slab(n, bytes, align);
+    }
+
+    template <typename T>
+    [[nodiscard]] T *objects() noexcept
+    {
+        return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(this) + headerSize<T>());
+    }
+
+    void release(std::size_t refs = 1) noexcept
+    {
+        if (m_refs.fetch_sub(refs, std::memory_order_acq_rel) == refs)
+        {
+            const std::size_t bytes = m_bytes;
+            const std::align_val_t align = m_align;
+            this->~Slab();
+            ::operator delete(static_cast<void *>(this), bytes, align);
+        }
+    }
+
+    [[nodiscard]] std::size_t refs() const noexcept { return m_refs.load(std::memory_order_relaxed); }
+};
+
+template <typename T>
+struct SlabDeleter
+{
+    Slab *m_slab = nullptr;
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_ptr->~T();
+        m_slab->release();
+    }
+};
+
+// Builds n independent owners whose objects are contiguous in one allocation.
+// Every object is constructed from the same args, which are therefore not forwarded.
+template <typename T, typename... Args>
+    requires(!std::is_array_v<T>)
+std::vector<UniquePtr<T, SlabDeleter<T>>> make_unique_batch(std::size_t n, const Args &...args)
+{
+    std::vector<UniquePtr<T, SlabDeleter<T>>> owners;
+    if (n == 0)
+    {
+        return owners;
+    }
+    owners.reserve(n);
+
+    Slab *slab = Slab::create<T>(n);
+    T *objects = slab->objects<T>();
+
+    std::size_t built = 0;
+    try
+    {
+        for (; built < n; ++built)
+        {
+            T *object = new (objects + built) T(args...);
+            owners.emplace_back(object, SlabDeleter<T>{slab});
+        }
+    }
+    catch (...)
+    {
+        // Owners already built release their own references as owners unwinds
+        slab->release(n - built);
+        throw;
+    }
+
+    return owners;
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "retired.hpp"
+#include "unique.hpp"
+
+// Process-wide sink for retired objects.
+// With the background thread running, submitted batches are destroyed there;
+// otherwise they wait for an explicit drain() at a quiescent point.
+class Reclaimer
+{
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<RetiredObject> m_pending;
+    std::thread m_worker;
+    bool m_stopping = false;
+
+private:
+    Reclaimer() = default;
+
+    // Destroys everything currently pending; returns false when there was nothing to do
+    bool drainOnce()
+    {
+        std::vector<RetiredObject> batch;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            batch.swap(m_pending);
+        }
+
+        detail::destroyAll(batch);
+        return !batch.empty();
+    }
+
+    void run();
+
+public:
+    // Runs after every thread's batch has been flushed, including main's
+    ~Reclaimer()
+    {
+        stop();
+        while (drainOnce())
+        {
+        }
+    }
+
+    Reclaimer(const Reclaimer &) = delete;
+    Reclaimer &operator=(const Reclaimer &) = delete;
+
+    static Reclaimer &instance()
+    {
+        static Reclaimer reclaimer;
+        return reclaimer;
+    }
+
+    // Launch the background reclamation thread
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_worker.joinable())
+        {
+            m_stopping = false;
+            m_worker = std::thread([this]
+                                   { run(); });
+        }
+    }
+
+    // Stop the background thread; anything it has not reached stays pending
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_worker.joinable())
+            {
+                return;
+            }
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_worker.join();
+    }
+
+    void submit(std::vector<RetiredObject> &&batch)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_pending.empty())
+            {
+                m_pending.swap(batch);
+            }
+            else
+            {
+                m_pending.insert(m_pending.end(), batch.begin(), batch.end());
+            }
+        }
+        m_wake.notify_one();
+    }
+
+    // Destroy everything submitted so far on the calling thread
+    void drain();
+
+    [[nodiscard]] std::size_t pending()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+};
+
+// Per-thread buffer of retired objects, handed to the Reclaimer in batches
+class DeferredBatch
+{
+private:
+    std::vector<RetiredObject> m_objects;
+
+    DeferredBatch()
+    {
+        // Construct the Reclaimer first so it outlives every thread's batch
+        (void)Reclaimer::instance();
+        m_objects.reserve(kFlushThreshold);
+    }
+
+public:
+    static constexpr std::size_t kFlushThreshold = 256;
+
+    ~DeferredBatch()
+    {
+        flush();
+    }
+
+    DeferredBatch(const DeferredBatch &) = delete;
+    DeferredBatch &operator=(const DeferredBatch &) = delete;
+
+    static DeferredBatch &local()
+    {
+        thread_local DeferredBatch batch;
+        return batch;
+    }
+
+    // Throws only if object could not be batched, in which case the caller still owns it
+    void retire(RetiredObject object)
+    {
+        m_objects.push_back(object);
+        if (m_objects.size() >= kFlushThreshold)
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+                // The batch stays here and is handed over by a later flush
+            }
+        }
+    }
+
+    // On failure every object stays in this thread's batch
+    void flush()
+    {
+        if (m_objects.empty())
+        {
+            return;
+        }
+
+        std::vector<RetiredObject> batch;
+        batch.reserve(kFlushThreshold);
+        batch.swap(m_objects);
+        try
+        {
+            Reclaimer::instance().submit(std::move(batch));
+        }
+        catch (...)
+        {
+            m_objects.swap(batch);
+            throw;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_objects.size(); }
+};
+
+inline void Reclaimer::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]
+                    { return m_stopping || !m_pending.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+
+        lock.unlock();
+        drainOnce();
+        // Destructors may have retired nested objects into this thread's batch
+        DeferredBatch::local().flush();
+        lock.lock();
+    }
+}
+
+inline void Reclaimer::drain()
+{
+    do
+    {
+        DeferredBatch::local().flush();
+    } while (drainOnce());
+}
+
+// Flush the calling thread's batch and destroy everything pending.
+// Call at points where no reader can still be using retired objects.
+inline void reclaim_deferred()
+{
+    Reclaimer::instance().drain();
+}
+
+// Defers destruction to the Reclaimer instead of deleting inline.
+// Falls back to an immediate delete if the batch cannot grow.
+template <typename T>
+struct DeferredDeleter
+{
+    static void destroy(void *p) noexcept
+    {
+        delete static_cast<T *>(p);
+    }
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        try
+        {
+            DeferredBatch::local().retire(RetiredObject{m_ptr, &destroy});
+        }
+        catch (...)
+        {
+            delete m_ptr;
+        }
+    }
+};
+
+template <typename T>
+struct DeferredDeleter<T[]>
+{
+    static void destroy(void *p) noexcept
+    {
+        delete[] static_cast<T *>(p);
+    }
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        try
+        {
+            DeferredBatch::local().retire(RetiredObject{m_ptr, &destroy});
+        }
+        catch (...)
+        {
+            delete[] m_ptr;
+        }
+    }
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "retired.hpp"
+#include "unique.hpp"
+
+// Epoch-based reclamation.
+// Readers pin the current epoch for the duration of a read-side critical section;
+// retired objects are destroyed once the global epoch has advanced twice past
+// their retirement, which guarantees no pinned reader can still reach them.
+// Pinning and unpinning are a few atomic operations and never lock.
+class EpochManager
+{
+private:
+    static constexpr std::uint64_t kIdle = ~std::uint64_t{0};
+    static constexpr std::size_t kAdvanceInterval = 64;
+
+    struct Participant
+    {
+        std::atomic<std::uint64_t> m_epoch{kIdle};
+        std::atomic<bool> m_inUse{false};
+        Participant *m_next = nullptr;
+    };
+
+    std::atomic<std::uint64_t> m_epoch{0};
+    detail::SlotList<Participant> m_participants;
+
+    // Retired objects bucketed by retirement epoch modulo 3
+    std::mutex m_mutex;
+    std::vector<RetiredObject> m_limbo[3];
+    std::size_t m_retiredSinceAdvance = 0;
+
+private:
+    // Caller holds m_mutex. Moves objects that became safe into reclaimable.
+    // Throws only before changing any state.
+    bool tryAdvanceLocked(std::vector<RetiredObject> &reclaimable)
+    {
+        const std::uint64_t epoch = m_epoch.load();
+
+        for (Participant *p = m_participants.head(); p; p = p->m_next)
+        {
+            const std::uint64_t pinned = p->m_epoch.load();
+            if (pinned != kIdle && pinned != epoch)
+            {
+                return false;
+            }
+        }
+
+        // Bucket (epoch + 2) % 3 holds objects retired at epoch - 1
+        std::vector<RetiredObject> &bucket = m_limbo[(epoch + 2) % 3];
+        reclaimable.reserve(reclaimable.size() + bucket.size());
+
+        m_epoch.store(epoch + 1);
+        m_retiredSinceAdvance = 0;
+        reclaimable.insert(reclaimable.end(), bucket.begin(), bucket.end());
+        bucket.clear();
+        return true;
+    }
+
+public:
+    // Read-side critical section; retired objects seen inside it stay alive until it ends
+    class Guard
+    {
+    private:
+        Participant *m_participant;
+
+    public:
+        explicit Guard(EpochManager &manager) : m_participant(manager.m_participants.acquire())
+        {
+            m_participant->m_epoch.store(manager.m_epoch.load());
+        }
+
+        ~Guard()
+        {
+            m_participant->m_epoch.store(kIdle, std::memory_order_release);
+            detail::SlotList<Participant>::release(m_participant);
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+    };
+
+    EpochManager() = default;
+
+    // No guard may be alive when the manager is destroyed
+    ~EpochManager()
+    {
+        // Destructors may retire further objects into any bucket
+        while (!m_limbo[0].empty() || !m_limbo[1].empty() || !m_limbo[2].empty())
+        {
+            for (std::vector<RetiredObject> &bucket : m_limbo)
+            {
+                detail::destroyUntilEmpty(bucket);
+            }
+        }
+    }
+
+    EpochManager(const EpochManager &) = delete;
+    EpochManager &operator=(const EpochManager &) = delete;
+
+    static EpochManager &instance()
+    {
+        static EpochManager manager;
+        return manager;
+    }
+
+    [[nodiscard]] Guard pin()
+    {
+        return Guard(*this);
+    }
+
+    [[nodiscard]] std::uint64_t epoch() const noexcept
+    {
+        return m_epoch.load();
+    }
+
+    // Never throws, so owners can retire from destructors and reset()
+    void retire(RetiredObject object) noexcept
+    {
+        std::vector<RetiredObject> reclaimable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            try
+            {
+                m_limbo[m_epoch.load() % 3].push_back(object);
+            }
+            catch (...)
+            {
+                // Out of memory: a pinned reader may still use the object, so leaking it
+                // is the only safe choice
+                return;
+            }
+
+            if (++m_retiredSinceAdvance >= kAdvanceInterval)
+            {
+                try
+                {
+                    tryAdvanceLocked(reclaimable);
+                }
+                catch (...)
+                {
+                    // Nothing moved; a later retire() or collect() advances instead
+                }
+            }
+        }
+
+        // Destructors may retire further objects, so run them unlocked
+        detail::destroyAll(reclaimable);
+    }
+
+    // Advance as far as pinned readers allow and destroy everything that became safe.
+    // Returns the number of objects destroyed.
+    std::size_t collect()
+    {
+        std::vector<RetiredObject> reclaimable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (int i = 0; i < 3 && tryAdvanceLocked(reclaimable); ++i)
+            {
+            }
+        }
+
+        detail::destroyAll(reclaimable);
+        return reclaimable.size();
+    }
+
+    [[nodiscard]] std::size_t retired()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_limbo[0].size() + m_limbo[1].size() + m_limbo[2].size();
+    }
+};
+
+// Retires the object to an EpochManager instead of deleting it, so reset() and
+// destruction are safe while readers may still hold the raw pointer
+template <typename T>
+struct EpochDeleter
+{
+    EpochManager *m_manager = &EpochManager::instance();
+
+    static void destroy(void *p) noexcept
+    {
+        delete static_cast<T *>(p);
+    }
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_manager->retire(RetiredObject{m_ptr, &destroy});
+    }
+};
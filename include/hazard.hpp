@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "atomic_unique.hpp"
+#include "retired.hpp"
+#include "unique.hpp"
+
+// Hazard-pointer reclamation.
+// A reader publishes the pointer it is about to use in a hazard slot; retired
+// objects are destroyed only once no slot refers to them. Protection costs the
+// reader one store and one re-load, with no locks or reference counts.
+class HazardDomain
+{
+private:
+    struct Record
+    {
+        std::atomic<const void *> m_hazard{nullptr};
+        std::atomic<bool> m_inUse{false};
+        Record *m_next = nullptr;
+    };
+
+    detail::SlotList<Record> m_records;
+
+    std::mutex m_mutex;
+    std::vector<RetiredObject> m_retired;
+
+private:
+    // Scan once the retired list outgrows the number of hazards so each scan frees at least half
+    std::size_t scanThreshold() const noexcept
+    {
+        return 2 * m_records.size() + 16;
+    }
+
+    // Caller holds m_mutex. Moves every unprotected object into reclaimable.
+    // On failure m_retired keeps every object, possibly reordered.
+    void scanLocked(std::vector<RetiredObject> &reclaimable)
+    {
+        std::vector<const void *> hazards;
+        for (Record *r = m_records.head(); r; r = r->m_next)
+        {
+            if (const void *p = r->m_hazard.load())
+            {
+                hazards.push_back(p);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto protectedEnd = std::partition(m_retired.begin(), m_retired.end(), [&](const RetiredObject &object)
+                                           { return std::binary_search(hazards.begin(), hazards.end(),
+                                                                       static_cast<const void *>(object.m_ptr)); });
+        reclaimable.insert(reclaimable.end(), protectedEnd, m_retired.end());
+        m_retired.erase(protectedEnd, m_retired.end());
+    }
+
+public:
+    // Owns one hazard slot; protects at most one pointer at a time
+    class Guard
+    {
+    private:
+        Record *m_record;
+
+        template <typename Source>
+        auto protectFrom(const Source &src) noexcept
+        {
+            auto *p = src.load();
+            while (true)
+            {
+                m_record->m_hazard.store(p);
+                auto *again = src.load();
+                if (again == p)
+                {
+                    return p;
+                }
+                p = again;
+            }
+        }
+
+    public:
+        explicit Guard(HazardDomain &domain) : m_record(domain.m_records.acquire()) {}
+
+        ~Guard()
+        {
+            m_record->m_hazard.store(nullptr, std::memory_order_release);
+            detail::SlotList<Record>::release(m_record);
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        // Load src and keep the result alive until reset() or the guard dies
+        template <typename T>
+        [[nodiscard]] T *protect(const std::atomic<T *> &src) noexcept
+        {
+            return protectFrom(src);
+        }
+
+        template <typename T, typename Deleter>
+        [[nodiscard]] T *protect(const AtomicUniquePtr<T, Deleter> &src) noexcept
+        {
+            return protectFrom(src);
+        }
+
+        void reset() noexcept
+        {
+            m_record->m_hazard.store(nullptr, std::memory_order_release);
+        }
+    };
+
+    HazardDomain() = default;
+
+    // No guard may be alive when the domain is destroyed
+    ~HazardDomain()
+    {
+        detail::destroyUntilEmpty(m_retired);
+    }
+
+    HazardDomain(const HazardDomain &) = delete;
+    HazardDomain &operator=(const HazardDomain &) = delete;
+
+    static HazardDomain &instance()
+    {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    [[nodiscard]] Guard guard()
+    {
+        return Guard(*this);
+    }
+
+    // Never throws, so owners can retire from destructors and reset()
+    void retire(RetiredObject object) noexcept
+    {
+        std::vector<RetiredObject> reclaimable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            try
+            {
+                m_retired.push_back(object);
+            }
+            catch (...)
+            {
+                // Out of memory: a reader may still protect the object, so leaking it
+                // is the only safe choice
+                return;
+            }
+
+            if (m_retired.size() >= scanThreshold())
+            {
+                try
+                {
+                    scanLocked(reclaimable);
+                }
+                catch (...)
+                {
+                    // Everything stays retired; a later retire() or reclaim() scans again
+                    reclaimable.clear();
+                }
+            }
+        }
+
+        // Destructors may retire further objects, so run them unlocked
+        detail::destroyAll(reclaimable);
+    }
+
+    // Destroy every retired object no reader currently protects.
+    // Returns the number of objects destroyed.
+    std::size_t reclaim()
+    {
+        std::vector<RetiredObject> reclaimable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            scanLocked(reclaimable);
+        }
+
+        detail::destroyAll(reclaimable);
+        return reclaimable.size();
+    }
+
+    [[nodiscard]] std::size_t retired()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_retired.size();
+    }
+};
+
+// Retires the object to a HazardDomain instead of deleting it, so an owner can
+// reset() while readers still hold protected pointers
+template <typename T>
+struct HazardDeleter
+{
+    HazardDomain *m_domain = &HazardDomain::instance();
+
+    static void destroy(void *p) noexcept
+    {
+        delete static_cast<T *>(p);
+    }
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_domain->retire(RetiredObject{m_ptr, &destroy});
+    }
+};
@@ -0,0 +1,356 @@
+#pragma once
+
+// Opt-in allocation statistics for UniquePtr.
+// Define UNIQUE_PTR_INSTRUMENTATION before including any header of this library
+// (and consistently across the program) to record, per type, how many objects
+// UniquePtr took ownership of and gave up, their bytes, and a histogram of how
+// long they were owned. Without the macro the probe is an empty member and
+// every hook compiles away.
+//
+// Converting moves and the unique casts hand an object over without ending its
+// lifetime, so it stays accounted to the type it was first adopted as.
+//
+// Scalar UniquePtr is instrumented; array owners are not, as their element
+// count is not known to the pointer.
+
+#if defined(UNIQUE_PTR_INSTRUMENTATION)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "type_name.hpp"
+
+// Bucket i counts lifetimes in [2^i, 2^(i+1)) nanoseconds; the last bucket is open-ended
+inline constexpr std::size_t kLifetimeBuckets = 40;
+
+struct TypeStats
+{
+    std::string_view name;
+    std::size_t size = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t bytesAllocated = 0;
+    std::uint64_t bytesFreed = 0;
+    std::array<std::uint64_t, kLifetimeBuckets> lifetimes{};
+
+    [[nodiscard]] std::int64_t live() const noexcept
+    {
+        return static_cast<std::int64_t>(allocations - deallocations);
+    }
+
+    [[nodiscard]] std::int64_t liveBytes() const noexcept
+    {
+        return static_cast<std::int64_t>(bytesAllocated - bytesFreed);
+    }
+};
+
+// Counters are per thread and written only by their thread with plain relaxed
+// stores, so recording never locks or issues a read-modify-write. The mutex
+// guards the type table, thread registration and snapshots only.
+class Instrumentation
+{
+public:
+    static constexpr std::size_t kMaxTypes = 256;
+
+private:
+    struct Counters
+    {
+        std::atomic<std::uint64_t> m_allocations{0};
+        std::atomic<std::uint64_t> m_deallocations{0};
+        std::atomic<std::uint64_t> m_bytesAllocated{0};
+        std::atomic<std::uint64_t> m_bytesFreed{0};
+        std::array<std::atomic<std::uint64_t>, kLifetimeBuckets> m_lifetimes{};
+    };
+
+    struct ThreadCounters
+    {
+        // Allocated on first use of a type by this thread
+        std::array<std::atomic<Counters *>, kMaxTypes> m_types{};
+
+        ThreadCounters()
+        {
+            instance().attach(this);
+        }
+
+        ~ThreadCounters()
+        {
+            exited() = true;
+            instance().detach(this);
+            for (std::atomic<Counters *> &counters : m_types)
+            {
+                delete counters.load(std::memory_order_relaxed);
+            }
+        }
+
+        Counters *counters(std::size_t id) noexcept
+        {
+            Counters *c = m_types[id].load(std::memory_order_relaxed);
+            if (!c)
+            {
+                c = new (std::nothrow) Counters();
+                m_types[id].store(c, std::memory_order_release);
+            }
+            return c;
+        }
+    };
+
+    struct TypeInfo
+    {
+        std::string_view m_name;
+        std::size_t m_size;
+    };
+
+    std::mutex m_mutex;
+    // Entries are written once under m_mutex, before their id is handed out
+    std::array<TypeInfo, kMaxTypes> m_typeInfo{};
+    std::size_t m_typeCount = 0;
+    std::vector<ThreadCounters *> m_threads;
+    // Totals of threads that have exited
+    std::vector<TypeStats> m_exited;
+
+private:
+    static void bump(std::atomic<std::uint64_t> &counter, std::uint64_t n) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static std::size_t bucket(std::uint64_t nanoseconds) noexcept
+    {
+        std::size_t b = 0;
+        while (nanoseconds > 1 && b + 1 < kLifetimeBuckets)
+        {
+            nanoseconds >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+    // Set once the thread's counters are gone, e.g. for owners destroyed during static destruction
+    static bool &exited() noexcept
+    {
+        thread_local bool exited = false;
+        return exited;
+    }
+
+    // Null once the thread has exited, or if a type's counters could not be allocated
+    static Counters *local(std::size_t id) noexcept
+    {
+        if (id == kMaxTypes || exited())
+        {
+            return nullptr;
+        }
+        thread_local ThreadCounters counters;
+        return counters.counters(id);
+    }
+
+    static void accumulate(TypeStats &stats, const Counters &c) noexcept
+    {
+        stats.allocations += c.m_allocations.load(std::memory_order_relaxed);
+        stats.deallocations += c.m_deallocations.load(std::memory_order_relaxed);
+        stats.bytesAllocated += c.m_bytesAllocated.load(std::memory_order_relaxed);
+        stats.bytesFreed += c.m_bytesFreed.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < kLifetimeBuckets; ++i)
+        {
+            stats.lifetimes[i] += c.m_lifetimes[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Caller holds m_mutex
+    void accumulateLocked(std::vector<TypeStats> &stats, const ThreadCounters &thread) const noexcept
+    {
+        for (std::size_t id = 0; id < stats.size(); ++id)
+        {
+            if (const Counters *c = thread.m_types[id].load(std::memory_order_acquire))
+            {
+                accumulate(stats[id], *c);
+            }
+        }
+    }
+
+    void attach(ThreadCounters *thread)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(thread);
+    }
+
+    void detach(ThreadCounters *thread)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exited.resize(m_typeCount);
+        accumulateLocked(m_exited, *thread);
+        std::erase(m_threads, thread);
+    }
+
+    Instrumentation() = default;
+
+public:
+    Instrumentation(const Instrumentation &) = delete;
+    Instrumentation &operator=(const Instrumentation &) = delete;
+
+    static Instrumentation &instance()
+    {
+        static Instrumentation instrumentation;
+        return instrumentation;
+    }
+
+    // Stable per-type index; kMaxTypes once the table is full, which disables recording for T
+    template <typename T>
+    static std::size_t typeId()
+    {
+        static const std::size_t id = instance().registerType(type_name<T>(), sizeof(T));
+        return id;
+    }
+
+    std::size_t registerType(std::string_view name, std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_typeCount == kMaxTypes)
+        {
+            return kMaxTypes;
+        }
+        m_typeInfo[m_typeCount] = TypeInfo{name, size};
+        return m_typeCount++;
+    }
+
+    static std::uint64_t now() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    // id comes from typeId()
+    static void recordAllocation(std::size_t id) noexcept
+    {
+        if (Counters *c = local(id))
+        {
+            bump(c->m_allocations, 1);
+            bump(c->m_bytesAllocated, instance().m_typeInfo[id].m_size);
+        }
+    }
+
+    static void recordDeallocation(std::size_t id, std::uint64_t lifetime) noexcept
+    {
+        if (Counters *c = local(id))
+        {
+            bump(c->m_deallocations, 1);
+            bump(c->m_bytesFreed, instance().m_typeInfo[id].m_size);
+            bump(c->m_lifetimes[bucket(lifetime)], 1);
+        }
+    }
+
+    // Totals across all threads, live and exited, indexed like typeId()
+    [[nodiscard]] std::vector<TypeStats> snapshot()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::vector<TypeStats> stats(m_typeCount);
+        for (std::size_t id = 0; id < stats.size(); ++id)
+        {
+            stats[id].name = m_typeInfo[id].m_name;
+            stats[id].size = m_typeInfo[id].m_size;
+            if (id < m_exited.size())
+            {
+                stats[id].allocations = m_exited[id].allocations;
+                stats[id].deallocations = m_exited[id].deallocations;
+                stats[id].bytesAllocated = m_exited[id].bytesAllocated;
+                stats[id].bytesFreed = m_exited[id].bytesFreed;
+                stats[id].lifetimes = m_exited[id].lifetimes;
+            }
+        }
+
+        for (const ThreadCounters *thread : m_threads)
+        {
+            accumulateLocked(stats, *thread);
+        }
+        return stats;
+    }
+
+    // One JSON object per type
+    void writeJson(std::ostream &out)
+    {
+        out << "[";
+        const char *separator = "\n";
+        for (const TypeStats &s : snapshot())
+        {
+            out << separator << "  {\"type\": \"";
+            detail::writeJsonEscaped(out, s.name);
+            out << "\", \"size\": " << s.size
+                << ", \"allocations\": " << s.allocations << ", \"deallocations\": " << s.deallocations
+                << ", \"live\": " << s.live() << ", \"bytesAllocated\": " << s.bytesAllocated
+                << ", \"liveBytes\": " << s.liveBytes() << ", \"lifetimeLog2Ns\": [";
+            for (std::size_t i = 0; i < kLifetimeBuckets; ++i)
+            {
+                out << (i ? ", " : "") << s.lifetimes[i];
+            }
+            out << "]}";
+            separator = ",\n";
+        }
+        out << "\n]\n";
+    }
+};
+
+namespace detail
+{
+    // Remembers when the current object was adopted and the type it was adopted as
+    template <typename T>
+    struct LifetimeProbe
+    {
+        std::uint64_t m_born = 0;
+        std::size_t m_type = Instrumentation::kMaxTypes;
+
+        void acquire(const T *p) noexcept
+        {
+            if (p)
+            {
+                m_born = Instrumentation::now();
+                m_type = Instrumentation::typeId<T>();
+                Instrumentation::recordAllocation(m_type);
+            }
+        }
+
+        void release(const T *p) noexcept
+        {
+            if (p)
+            {
+                Instrumentation::recordDeallocation(m_type, Instrumentation::now() - m_born);
+            }
+        }
+
+        // The object moved to an owner of another type, e.g. Derived to Base;
+        // it stays accounted to the type it was adopted as
+        template <typename U>
+        void transfer(const LifetimeProbe<U> &other) noexcept
+        {
+            m_born = other.m_born;
+            m_type = other.m_type;
+        }
+    };
+}
+
+#else
+
+namespace detail
+{
+    template <typename T>
+    struct LifetimeProbe
+    {
+        void acquire(const T *) noexcept {}
+        void release(const T *) noexcept {}
+
+        template <typename U>
+        void transfer(const LifetimeProbe<U> &) noexcept
+        {
+        }
+    };
+}
+
+#endif
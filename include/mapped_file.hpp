@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "unique.hpp"
+#include "unique_handle.hpp"
+
+enum class MapMode
+{
+    ReadOnly,
+    // Writes go back to the file
+    ReadWrite,
+    // Writes stay private to the mapping
+    CopyOnWrite
+};
+
+enum class MapAdvice
+{
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+    // Ignored where transparent huge pages are unavailable
+    HugePage
+};
+
+struct MapOptions
+{
+    // Pre-fault every page up front instead of on first access (Linux only)
+    bool populate = false;
+    MapAdvice advice = MapAdvice::Normal;
+};
+
+// Carries the mapping length so the region can be unmapped
+struct MunmapDeleter
+{
+    std::size_t m_length = 0;
+
+    void operator()(void *m_ptr) const noexcept
+    {
+        ::munmap(m_ptr, m_length);
+    }
+};
+
+namespace detail
+{
+    inline int adviceFlag(MapAdvice advice) noexcept
+    {
+        switch (advice)
+        {
+        case MapAdvice::Sequential:
+            return MADV_SEQUENTIAL;
+        case MapAdvice::Random:
+            return MADV_RANDOM;
+        case MapAdvice::WillNeed:
+            return MADV_WILLNEED;
+#if defined(MADV_HUGEPAGE)
+        case MapAdvice::HugePage:
+            return MADV_HUGEPAGE;
+#endif
+        default:
+            return MADV_NORMAL;
+        }
+    }
+}
+
+// Maps the whole file without copying it. An empty file yields a null pointer.
+// The mapping length is available as getDeleter().m_length.
+inline UniquePtr<std::byte[], MunmapDeleter> map_file_unique(const std::filesystem::path &path,
+                                                             MapMode mode = MapMode::ReadOnly,
+                                                             MapOptions options = {})
+{
+    // The mapping keeps the file alive once the descriptor is closed
+    UniqueFd fd(::open(path.c_str(), (mode == MapMode::ReadWrite ? O_RDWR : O_RDONLY) | O_CLOEXEC));
+    if (!fd)
+    {
+        throw std::system_error(errno, std::generic_category(), "open " + path.string());
+    }
+
+    struct stat info;
+    if (::fstat(fd.get(), &info) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "fstat " + path.string());
+    }
+
+    const std::size_t length = static_cast<std::size_t>(info.st_size);
+    if (length == 0)
+    {
+        return UniquePtr<std::byte[], MunmapDeleter>();
+    }
+
+    const int prot = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = mode == MapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+    if (options.populate)
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif
+
+    void *p = ::mmap(nullptr, length, prot, flags, fd.get(), 0);
+    if (p == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap " + path.string());
+    }
+
+    // Advice is only a hint, so a kernel that rejects it is not an error
+    if (options.advice != MapAdvice::Normal)
+    {
+        ::madvise(p, length, detail::adviceFlag(options.advice));
+    }
+
+    return UniquePtr<std::byte[], MunmapDeleter>(static_cast<std::byte *>(p), MunmapDeleter{length});
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "unique.hpp"
+
+// NUMA placement is page-granular: every object gets its own anonymous mapping,
+// so these factories suit large objects and buffers rather than small nodes.
+namespace detail
+{
+#if defined(__linux__)
+    // Maps bytes of anonymous memory bound to node. Pages are not touched here,
+    // so constructing the object afterwards faults them in on that node.
+    inline void *numaAllocate(std::size_t bytes, int node)
+    {
+        if (node < 0)
+        {
+            throw std::system_error(EINVAL, std::generic_category(), "numaAllocate: negative node");
+        }
+
+        void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+
+        constexpr std::size_t kBits = sizeof(unsigned long) * CHAR_BIT;
+        const std::size_t words = static_cast<std::size_t>(node) / kBits + 1;
+        std::unique_ptr<unsigned long[]> mask(new unsigned long[words]());
+        mask[static_cast<std::size_t>(node) / kBits] = 1UL << (static_cast<std::size_t>(node) % kBits);
+
+        // The kernel ignores the last bit of maxnode, hence the + 1
+        if (::syscall(SYS_mbind, p, bytes, MPOL_BIND, mask.get(), words * kBits + 1, 0) != 0)
+        {
+            const int error = errno;
+            // Kernels built without NUMA have exactly one node
+            if (!(error == ENOSYS && node == 0))
+            {
+                ::munmap(p, bytes);
+                throw std::system_error(error, std::generic_category(), "mbind");
+            }
+        }
+
+        return p;
+    }
+
+    inline void numaFree(void *p, std::size_t bytes) noexcept
+    {
+        ::munmap(p, bytes);
+    }
+#else
+    // Without NUMA support every allocation lands on the only node
+    inline void *numaAllocate(std::size_t bytes, int node)
+    {
+        if (node != 0)
+        {
+            throw std::system_error(EINVAL, std::generic_category(), "numaAllocate: NUMA is not supported");
+        }
+        return ::operator new(bytes);
+    }
+
+    inline void numaFree(void *p, std::size_t) noexcept
+    {
+        ::operator delete(p);
+    }
+#endif
+}
+
+// Node currently backing the page at p, or -1 if it cannot be determined
+inline int numa_node_of(const void *p) noexcept
+{
+#if defined(__linux__)
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, const_cast<void *>(p), MPOL_F_NODE | MPOL_F_ADDR) != 0)
+    {
+        return -1;
+    }
+    return node;
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+// Carries the mapping length so the memory can be unmapped
+template <typename T>
+struct NumaDeleter
+{
+    std::size_t m_length = 0;
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_ptr->~T();
+        detail::numaFree(m_ptr, m_length);
+    }
+};
+
+template <typename T>
+struct NumaDeleter<T[]>
+{
+    std::size_t m_length = 0;
+    std::size_t m_count = 0;
+
+    void operator()(T *m_ptr) const noexcept
+    {
+        std::destroy_n(m_ptr, m_count);
+        detail::numaFree(m_ptr, m_length);
+    }
+};
+
+template <typename T, typename... Args>
+    requires(!std::is_array_v<T>)
+UniquePtr<T, NumaDeleter<T>> make_unique_on_node(int node, Args &&...args)
+{
+    void *storage = detail::numaAllocate(sizeof(T), node);
+
+    try
+    {
+        T *object = new (storage) T(std::forward<Args>(args)...);
+        return UniquePtr<T, NumaDeleter<T>>(object, NumaDeleter<T>{sizeof(T)});
+    }
+    catch (...)
+    {
+        detail::numaFree(storage, sizeof(T));
+        throw;
+    }
+}
+
+// Elements are default-initialised like make_unique(size_t)
+template <typename T>
+    requires std::is_unbounded_array_v<T>
+UniquePtr<T, NumaDeleter<T>> make_unique_on_node(int node, size_t size)
+{
+    using Elem = std::remove_extent_t<T>;
+
+    if (size > static_cast<size_t>(-1) / sizeof(Elem))
+    {
+        throw std::bad_array_new_length();
+    }
+
+    // mmap rejects zero-length mappings
+    const std::size_t bytes = size == 0 ? 1 : size * sizeof(Elem);
+    void *storage = detail::numaAllocate(bytes, node);
+
+    try
+    {
+        Elem *elements = static_cast<Elem *>(storage);
+        std::uninitialized_default_construct_n(elements, size);
+        return UniquePtr<T, NumaDeleter<T>>(elements, NumaDeleter<T>{bytes, size});
+    }
+    catch (...)
+    {
+        detail::numaFree(storage, bytes);
+        throw;
+    }
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "unique.hpp"
+
+namespace detail
+{
+    template <typename T>
+    union PoolSlot
+    {
+        PoolSlot *m_next;
+        alignas(T) unsigned char m_storage[sizeof(T)];
+    };
+
+    template <typename T>
+    struct PoolChain
+    {
+        PoolSlot<T> *m_head = nullptr;
+        std::size_t m_count = 0;
+    };
+
+    // Process-wide owner of every slab carved for T.
+    // Threads take free slots from here one slab at a time and hand back slots
+    // beyond their local cap, and all of them when they exit, so a slot freed on
+    // one thread becomes available to every other thread.
+    template <typename T>
+    class PoolSlabs
+    {
+    private:
+        using Slot = PoolSlot<T>;
+
+        std::mutex m_mutex;
+        std::vector<UniquePtr<Slot[]>> m_slabs;
+        Slot *m_orphans = nullptr;
+        std::size_t m_orphanCount = 0;
+
+    public:
+        // Roughly one page per slab, but never fewer than 16 slots
+        static constexpr std::size_t kSlotsPerSlab = std::max<std::size_t>(16, 4096 / sizeof(Slot));
+
+        static PoolSlabs &instance()
+        {
+            static PoolSlabs slabs;
+            return slabs;
+        }
+
+        // Returns a null-terminated chain of free slots
+        [[nodiscard]] PoolChain<T> acquire()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_orphans)
+            {
+                return {std::exchange(m_orphans, nullptr), std::exchange(m_orphanCount, 0)};
+            }
+
+            m_slabs.push_back(UniquePtr<Slot[]>(new Slot[kSlotsPerSlab]));
+            Slot *slab = m_slabs.back().get();
+            for (std::size_t i = 0; i + 1 < kSlotsPerSlab; ++i)
+            {
+                slab[i].m_next = &slab[i + 1];
+            }
+            slab[kSlotsPerSlab - 1].m_next = nullptr;
+
+            return {slab, kSlotsPerSlab};
+        }
+
+        // Takes back a chain of count free slots from head to tail
+        void adopt(Slot *head, Slot *tail, std::size_t count) noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tail->m_next = m_orphans;
+            m_orphans = head;
+            m_orphanCount += count;
+        }
+
+        [[nodiscard]] std::size_t slabCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_slabs.size();
+        }
+    };
+}
+
+// Per-thread free list of fixed-size slots for T.
+// Allocation and deallocation never lock; only refilling an empty list and
+// spilling an overfull one do. A thread that only frees (the consumer side of a
+// producer/consumer pair) keeps at most kLocalCapacity slots and spills the rest
+// back to PoolSlabs, where the allocating thread picks them up again.
+// Slabs are released at program exit, so pooled objects must not outlive main().
+template <typename T>
+class ObjectPool
+{
+private:
+    using Slot = detail::PoolSlot<T>;
+    using Slabs = detail::PoolSlabs<T>;
+
+    Slot *m_free = nullptr;
+    std::size_t m_count = 0;
+
+    ObjectPool() = default;
+
+    // Hands the first count slots of the free list back to PoolSlabs
+    void spill(std::size_t count) noexcept
+    {
+        Slot *head = m_free;
+        Slot *tail = head;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            tail = tail->m_next;
+        }
+
+        m_free = tail->m_next;
+        m_count -= count;
+        Slabs::instance().adopt(head, tail, count);
+    }
+
+public:
+    static constexpr std::size_t kLocalCapacity = 2 * Slabs::kSlotsPerSlab;
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    ~ObjectPool()
+    {
+        if (m_free)
+        {
+            spill(m_count);
+        }
+    }
+
+    // Pool of the calling thread
+    static ObjectPool &local()
+    {
+        thread_local ObjectPool pool;
+        return pool;
+    }
+
+    // Returns uninitialised storage for one T
+    [[nodiscard]] void *allocate()
+    {
+        if (!m_free)
+        {
+            detail::PoolChain<T> chain = Slabs::instance().acquire();
+            m_free = chain.m_head;
+            m_count = chain.m_count;
+        }
+
+        Slot *slot = m_free;
+        m_free = slot->m_next;
+        --m_count;
+        return slot->m_storage;
+    }
+
+    // Returns storage obtained from any thread's allocate() to this thread's list,
+    // spilling a slab's worth of slots once the list reaches kLocalCapacity
+    void deallocate(void *p) noexcept
+    {
+        Slot *slot = static_cast<Slot *>(p);
+        slot->m_next = m_free;
+        m_free = slot;
+
+        if (++m_count >= kLocalCapacity)
+        {
+            spill(Slabs::kSlotsPerSlab);
+        }
+    }
+
+    [[nodiscard]] std::size_t cachedSlots() const noexcept { return m_count; }
+};
+
+template <typename T>
+struct PoolDeleter
+{
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_ptr->~T();
+        ObjectPool<T>::local().deallocate(m_ptr);
+    }
+};
+
+template <typename T, typename... Args>
+UniquePtr<T, PoolDeleter<T>> make_pooled_unique(Args &&...args)
+{
+    ObjectPool<T> &pool = ObjectPool<T>::local();
+    void *slot = pool.allocate();
+
+    try
+    {
+        return UniquePtr<T, PoolDeleter<T>>(new (slot) T(std::forward<Args>(args)...));
+    }
+    catch (...)
+    {
+        pool.deallocate(slot);
+        throw;
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "unique.hpp"
+
+struct RecycleStats
+{
+    std::size_t hits = 0;     // make_recycled served from the cache
+    std::size_t misses = 0;   // make_recycled had to allocate
+    std::size_t recycled = 0; // destroyed objects whose storage was kept
+    std::size_t released = 0; // destroyed objects freed because the cache was full
+};
+
+// Bounded per-thread cache of storage from destroyed T objects.
+// Free blocks are linked through their own storage, so the cache needs no extra memory.
+// Storage comes from the global allocator, so objects may be destroyed on any thread.
+template <typename T>
+class RecycleCache
+{
+private:
+    struct FreeBlock
+    {
+        FreeBlock *m_next;
+    };
+
+    static constexpr std::size_t kBlockSize = std::max(sizeof(T), sizeof(FreeBlock));
+    static constexpr std::align_val_t kBlockAlign{std::max(alignof(T), alignof(FreeBlock))};
+
+    FreeBlock *m_free = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = kDefaultCapacity;
+    RecycleStats m_stats;
+
+    RecycleCache() = default;
+
+    void releaseOne() noexcept
+    {
+        ::operator delete(std::exchange(m_free, m_free->m_next), kBlockAlign);
+        --m_size;
+    }
+
+public:
+    static constexpr std::size_t kDefaultCapacity = 64;
+
+    ~RecycleCache()
+    {
+        while (m_free)
+        {
+            releaseOne();
+        }
+    }
+
+    RecycleCache(const RecycleCache &) = delete;
+    RecycleCache &operator=(const RecycleCache &) = delete;
+
+    // Cache of the calling thread
+    static RecycleCache &local()
+    {
+        thread_local RecycleCache cache;
+        return cache;
+    }
+
+    // Returns uninitialised storage for one T
+    [[nodiscard]] void *acquire()
+    {
+        if (m_free)
+        {
+            ++m_stats.hits;
+            --m_size;
+            return std::exchange(m_free, m_free->m_next);
+        }
+
+        ++m_stats.misses;
+        return ::operator new(kBlockSize, kBlockAlign);
+    }
+
+    // Keeps the storage of a destroyed T if there is room, frees it otherwise
+    void recycle(void *p) noexcept
+    {
+        if (m_size < m_capacity)
+        {
+            m_free = new (p) FreeBlock{m_free};
+            ++m_size;
+            ++m_stats.recycled;
+        }
+        else
+        {
+            ::operator delete(p, kBlockAlign);
+            ++m_stats.released;
+        }
+    }
+
+    // Shrinking the capacity frees cached blocks beyond it
+    void setCapacity(std::size_t capacity) noexcept
+    {
+        m_capacity = capacity;
+        while (m_size > m_capacity)
+        {
+            releaseOne();
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] const RecycleStats &stats() const noexcept { return m_stats; }
+
+    void resetStats() noexcept
+    {
+        m_stats = RecycleStats{};
+    }
+};
+
+template <typename T>
+struct RecyclingDeleter
+{
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_ptr->~T();
+        RecycleCache<T>::local().recycle(m_ptr);
+    }
+};
+
+template <typename T, typename... Args>
+UniquePtr<T, RecyclingDeleter<T>> make_recycled(Args &&...args)
+{
+    RecycleCache<T> &cache = RecycleCache<T>::local();
+    void *storage = cache.acquire();
+
+    try
+    {
+        return UniquePtr<T, RecyclingDeleter<T>>(new (storage) T(std::forward<Args>(args)...));
+    }
+    catch (...)
+    {
+        cache.recycle(storage);
+        throw;
+    }
+}
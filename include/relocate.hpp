@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "unique.hpp"
+
+// Moves [first, last) into uninitialised storage at dest and ends the lifetime
+// of the source objects. Ranges must not overlap.
+template <typename T>
+T *relocate(T *first, T *last, T *dest) noexcept
+{
+    static_assert(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>,
+                  "relocate requires a trivially relocatable or nothrow-movable type");
+
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        if (count != 0)
+        {
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+        }
+        return dest + count;
+    }
+    else
+    {
+        for (; first != last; ++first, ++dest)
+        {
+            std::construct_at(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+        return dest;
+    }
+}
+
+// Minimal growable array that relocates its elements on reallocation,
+// turning growth of trivially relocatable elements into a single memcpy
+template <typename T>
+class RelocatingVector
+{
+private:
+    T *m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = 0;
+
+private:
+    static T *allocate(std::size_t capacity)
+    {
+        return static_cast<T *>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    static void deallocate(T *p) noexcept
+    {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    std::size_t nextCapacity() const noexcept
+    {
+        return m_capacity == 0 ? 4 : m_capacity * 2;
+    }
+
+    void swap(RelocatingVector &other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    RelocatingVector() noexcept = default;
+
+    ~RelocatingVector()
+    {
+        clear();
+        deallocate(m_data);
+    }
+
+    // Not copyable
+    RelocatingVector(const RelocatingVector &) = delete;
+    RelocatingVector &operator=(const RelocatingVector &) = delete;
+
+    // Move semantics
+    RelocatingVector(RelocatingVector &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_capacity(std::exchange(other.m_capacity, 0))
+    {
+    }
+
+    RelocatingVector &operator=(RelocatingVector &&other) noexcept
+    {
+        RelocatingVector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+public:
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] T *data() noexcept { return m_data; }
+    [[nodiscard]] const T *data() const noexcept { return m_data; }
+
+    [[nodiscard]] iterator begin() noexcept { return m_data; }
+    [[nodiscard]] iterator end() noexcept { return m_data + m_size; }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+    [[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+
+    [[nodiscard]] T &operator[](std::size_t i) noexcept { return m_data[i]; }
+    [[nodiscard]] const T &operator[](std::size_t i) const noexcept { return m_data[i]; }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+
+        T *grown = allocate(capacity);
+        relocate(m_data, m_data + m_size, grown);
+        deallocate(std::exchange(m_data, grown));
+        m_capacity = capacity;
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (m_size < m_capacity)
+        {
+            T &element = *std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+            return element;
+        }
+
+        // Build the new element first: args may refer to an element being relocated
+        const std::size_t capacity = nextCapacity();
+        T *grown = allocate(capacity);
+        try
+        {
+            std::construct_at(grown + m_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(grown);
+            throw;
+        }
+
+        relocate(m_data, m_data + m_size, grown);
+        deallocate(std::exchange(m_data, grown));
+        m_capacity = capacity;
+        return m_data[m_size++];
+    }
+
+    void push_back(T &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept
+    {
+        std::destroy_at(m_data + --m_size);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    friend void swap(RelocatingVector &a, RelocatingVector &b) noexcept
+    {
+        a.swap(b);
+    }
+};
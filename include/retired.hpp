@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Retired objects and reader slots shared by the reclamation schemes in deferred.hpp,
+// epoch.hpp and hazard.hpp
+
+// Type-erased object waiting to be destroyed
+struct RetiredObject
+{
+    void *m_ptr;
+    void (*m_destroy)(void *) noexcept;
+
+    void destroy() const noexcept
+    {
+        m_destroy(m_ptr);
+    }
+};
+
+namespace detail
+{
+    inline void destroyAll(const std::vector<RetiredObject> &objects) noexcept
+    {
+        for (const RetiredObject &object : objects)
+        {
+            object.destroy();
+        }
+    }
+
+    // Destructors may retire further objects into the same list, so destroy
+    // from a swapped-out copy until nothing new arrives
+    inline void destroyUntilEmpty(std::vector<RetiredObject> &objects) noexcept
+    {
+        while (!objects.empty())
+        {
+            const std::vector<RetiredObject> batch = std::exchange(objects, {});
+            destroyAll(batch);
+        }
+    }
+
+    // Per-reader slots of a reclamation domain, reused once released.
+    // Slots are never unlinked while the list lives, so a lock-free push is enough.
+    // Slot provides std::atomic<bool> m_inUse and Slot *m_next.
+    template <typename Slot>
+    class SlotList
+    {
+    private:
+        std::atomic<Slot *> m_head{nullptr};
+        std::atomic<std::size_t> m_size{0};
+
+    public:
+        SlotList() = default;
+
+        ~SlotList()
+        {
+            Slot *slot = m_head.load();
+            while (slot)
+            {
+                delete std::exchange(slot, slot->m_next);
+            }
+        }
+
+        SlotList(const SlotList &) = delete;
+        SlotList &operator=(const SlotList &) = delete;
+
+        [[nodiscard]] Slot *acquire()
+        {
+            for (Slot *slot = m_head.load(std::memory_order_acquire); slot; slot = slot->m_next)
+            {
+                bool expected = false;
+                if (!slot->m_inUse.load(std::memory_order_relaxed) &&
+                    slot->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return slot;
+                }
+            }
+
+            Slot *slot = new Slot();
+            slot->m_inUse.store(true, std::memory_order_relaxed);
+            slot->m_next = m_head.load(std::memory_order_relaxed);
+            while (!m_head.compare_exchange_weak(slot->m_next, slot, std::memory_order_release,
+                                                 std::memory_order_relaxed))
+            {
+            }
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return slot;
+        }
+
+        static void release(Slot *slot) noexcept
+        {
+            slot->m_inUse.store(false, std::memory_order_release);
+        }
+
+        [[nodiscard]] Slot *head() const noexcept { return m_head.load(); }
+
+        [[nodiscard]] std::size_t size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+    };
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "unique.hpp"
+
+// Per-thread block cache for T with lock-free cross-thread frees.
+// Every block records the cache that allocated it. Frees on the owning thread
+// push onto a plain local list; frees on any other thread push onto the owner's
+// lock-free remote list, which the owner drains the next time its local list runs dry.
+// A cache outlives its thread until every block it handed out has been freed.
+template <typename T>
+class ThreadCache
+{
+private:
+    struct Header
+    {
+        ThreadCache *m_owner;
+        Header *m_next;
+    };
+
+    static constexpr std::size_t kAlign = std::max(alignof(T), alignof(Header));
+    static constexpr std::size_t kHeaderSize = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+    static constexpr std::size_t kBlockSize = kHeaderSize + sizeof(T);
+
+    Header *m_local = nullptr;
+    std::size_t m_localCount = 0;
+    std::atomic<Header *> m_remote{nullptr};
+    std::atomic<bool> m_orphaned{false};
+    // One reference for the owning thread, one per block obtained from the global allocator
+    // and one per remote free in progress
+    std::atomic<std::size_t> m_refs{1};
+
+    // Destroys the thread's cache on thread exit
+    struct Handle
+    {
+        ThreadCache *m_cache;
+
+        Handle() : m_cache(new ThreadCache())
+        {
+            current() = m_cache;
+        }
+
+        ~Handle()
+        {
+            current() = nullptr;
+            m_cache->orphan();
+        }
+    };
+
+    ThreadCache() = default;
+
+private:
+    // The calling thread's cache, or null if it has none (yet or any more).
+    // A plain pointer, so it stays readable while thread_locals are being destroyed.
+    static ThreadCache *&current() noexcept
+    {
+        thread_local ThreadCache *cache = nullptr;
+        return cache;
+    }
+
+    static Header *header(void *object) noexcept
+    {
+        return reinterpret_cast<Header *>(static_cast<unsigned char *>(object) - kHeaderSize);
+    }
+
+    static void *object(Header *block) noexcept
+    {
+        return reinterpret_cast<unsigned char *>(block) + kHeaderSize;
+    }
+
+    void acquireRef() noexcept
+    {
+        m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void releaseRef() noexcept
+    {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+    void releaseBlock(Header *block) noexcept
+    {
+        ::operator delete(block, std::align_val_t(kAlign));
+        releaseRef();
+    }
+
+    void releaseChain(Header *block) noexcept
+    {
+        while (block)
+        {
+            releaseBlock(std::exchange(block, block->m_next));
+        }
+    }
+
+    void pushLocal(Header *block) noexcept
+    {
+        if (m_localCount < kLocalCapacity)
+        {
+            block->m_next = m_local;
+            m_local = block;
+            ++m_localCount;
+        }
+        else
+        {
+            releaseBlock(block);
+        }
+    }
+
+    void pushRemote(Header *block) noexcept
+    {
+        // Keeps the cache alive until we have checked whether it was orphaned
+        acquireRef();
+
+        block->m_next = m_remote.load(std::memory_order_relaxed);
+        while (!m_remote.compare_exchange_weak(block->m_next, block))
+        {
+        }
+
+        // The owner has exited: nobody else will drain the remote list
+        if (m_orphaned.load())
+        {
+            releaseChain(m_remote.exchange(nullptr));
+        }
+
+        releaseRef();
+    }
+
+    void orphan() noexcept
+    {
+        m_orphaned.store(true);
+        releaseChain(m_remote.exchange(nullptr));
+        releaseChain(std::exchange(m_local, nullptr));
+        m_localCount = 0;
+        releaseRef();
+    }
+
+public:
+    static constexpr std::size_t kLocalCapacity = 1024;
+
+    ThreadCache(const ThreadCache &) = delete;
+    ThreadCache &operator=(const ThreadCache &) = delete;
+
+    // Cache of the calling thread
+    static ThreadCache &local()
+    {
+        thread_local Handle handle;
+        return *handle.m_cache;
+    }
+
+    // Returns uninitialised storage for one T, owned by this cache
+    [[nodiscard]] void *allocate()
+    {
+        if (!m_local)
+        {
+            for (Header *block = m_remote.exchange(nullptr, std::memory_order_acquire); block;)
+            {
+                pushLocal(std::exchange(block, block->m_next));
+            }
+        }
+
+        Header *block = m_local;
+        if (block)
+        {
+            m_local = block->m_next;
+            --m_localCount;
+        }
+        else
+        {
+            block = static_cast<Header *>(::operator new(kBlockSize, std::align_val_t(kAlign)));
+            block->m_owner = this;
+            acquireRef();
+        }
+        return object(block);
+    }
+
+    // Returns storage from allocate() to its owning cache, from any thread
+    static void deallocate(void *p) noexcept
+    {
+        Header *block = header(p);
+        ThreadCache *owner = block->m_owner;
+
+        if (owner == current())
+        {
+            owner->pushLocal(block);
+        }
+        else
+        {
+            owner->pushRemote(block);
+        }
+    }
+
+    [[nodiscard]] std::size_t cachedBlocks() const noexcept { return m_localCount; }
+};
+
+template <typename T>
+struct CachedDeleter
+{
+    void operator()(T *m_ptr) const noexcept
+    {
+        m_ptr->~T();
+        ThreadCache<T>::deallocate(m_ptr);
+    }
+};
+
+template <typename T, typename... Args>
+UniquePtr<T, CachedDeleter<T>> make_unique_cached(Args &&...args)
+{
+    void *storage = ThreadCache<T>::local().allocate();
+
+    try
+    {
+        return UniquePtr<T, CachedDeleter<T>>(new (storage) T(std::forward<Args>(args)...));
+    }
+    catch (...)
+    {
+        ThreadCache<T>::deallocate(storage);
+        throw;
+    }
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "type_name.hpp"
+#include "unique.hpp"
+
+// One destruction: when and on which thread the object was adopted, and when
+// the deleter started and finished on the freeing thread
+struct TraceEvent
+{
+    std::string_view type;
+    std::uintptr_t object = 0;
+    std::uint64_t born = 0;
+    std::uint32_t bornThread = 0;
+    std::uint64_t freeBegin = 0;
+    std::uint64_t freeEnd = 0;
+    std::uint32_t thread = 0;
+};
+
+// Fixed-size multi-producer ring of trace events; once full, the oldest are overwritten.
+// Writers claim a slot with one fetch_add and publish it with a sequence number,
+// so recording never locks. Readers skip slots that are being rewritten.
+class TraceBuffer
+{
+private:
+    struct Slot
+    {
+        // Index + 1 of the event in the slot, 0 while it is being written
+        std::atomic<std::uint64_t> m_seq{0};
+        std::atomic<const std::string_view *> m_type{nullptr};
+        std::atomic<std::uintptr_t> m_object{0};
+        std::atomic<std::uint64_t> m_born{0};
+        std::atomic<std::uint32_t> m_bornThread{0};
+        std::atomic<std::uint64_t> m_freeBegin{0};
+        std::atomic<std::uint64_t> m_freeEnd{0};
+        std::atomic<std::uint32_t> m_thread{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+    std::atomic<std::uint64_t> m_head{0};
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t n) noexcept
+    {
+        std::size_t capacity = 1;
+        while (capacity < n)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+public:
+    static constexpr std::size_t kDefaultCapacity = 1 << 16;
+
+    // Capacity is rounded up to a power of two
+    explicit TraceBuffer(std::size_t capacity = kDefaultCapacity)
+        : m_slots(new Slot[roundUpToPowerOfTwo(capacity)]), m_mask(roundUpToPowerOfTwo(capacity) - 1)
+    {
+    }
+
+    TraceBuffer(const TraceBuffer &) = delete;
+    TraceBuffer &operator=(const TraceBuffer &) = delete;
+
+    static TraceBuffer &instance()
+    {
+        static TraceBuffer buffer;
+        return buffer;
+    }
+
+    static std::uint64_t now() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+    // Small stable id for the calling thread, as trace viewers expect
+    static std::uint32_t threadId() noexcept
+    {
+        static std::atomic<std::uint32_t> next{1};
+        thread_local const std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    // type must outlive the buffer, e.g. a static holding type_name<T>()
+    void record(const std::string_view *type, const void *object, std::uint64_t born, std::uint32_t bornThread,
+                std::uint64_t freeBegin, std::uint64_t freeEnd) noexcept
+    {
+        const std::uint64_t index = m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot &slot = m_slots[index & m_mask];
+
+        slot.m_seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.m_type.store(type, std::memory_order_relaxed);
+        slot.m_object.store(reinterpret_cast<std::uintptr_t>(object), std::memory_order_relaxed);
+        slot.m_born.store(born, std::memory_order_relaxed);
+        slot.m_bornThread.store(bornThread, std::memory_order_relaxed);
+        slot.m_freeBegin.store(freeBegin, std::memory_order_relaxed);
+        slot.m_freeEnd.store(freeEnd, std::memory_order_relaxed);
+        slot.m_thread.store(threadId(), std::memory_order_relaxed);
+        slot.m_seq.store(index + 1, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    // Events recorded so far, including those already overwritten
+    [[nodiscard]] std::uint64_t recorded() const noexcept { return m_head.load(std::memory_order_relaxed); }
+
+    // Calls fn for every complete event still in the buffer, oldest first
+    template <typename Fn>
+    void forEach(Fn &&fn) const
+    {
+        const std::uint64_t head = m_head.load(std::memory_order_acquire);
+        const std::uint64_t first = head > capacity() ? head - capacity() : 0;
+
+        for (std::uint64_t index = first; index < head; ++index)
+        {
+            const Slot &slot = m_slots[index & m_mask];
+            if (slot.m_seq.load(std::memory_order_acquire) != index + 1)
+            {
+                continue;
+            }
+
+            TraceEvent event;
+            const std::string_view *type = slot.m_type.load(std::memory_order_relaxed);
+            event.object = slot.m_object.load(std::memory_order_relaxed);
+            event.born = slot.m_born.load(std::memory_order_relaxed);
+            event.bornThread = slot.m_bornThread.load(std::memory_order_relaxed);
+            event.freeBegin = slot.m_freeBegin.load(std::memory_order_relaxed);
+            event.freeEnd = slot.m_freeEnd.load(std::memory_order_relaxed);
+            event.thread = slot.m_thread.load(std::memory_order_relaxed);
+
+            // A writer may have reclaimed the slot while we were copying it
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_seq.load(std::memory_order_relaxed) != index + 1)
+            {
+                continue;
+            }
+
+            event.type = *type;
+            fn(event);
+        }
+    }
+
+    // Chrome trace event format, viewable in Perfetto or chrome://tracing.
+    // Each object's lifetime is an async slice opened on the adopting thread and
+    // closed on the freeing one; each deleter call is a complete slice.
+    void writeChromeTrace(std::ostream &out) const
+    {
+        const auto micros = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        const auto name = [&](std::string_view prefix, std::string_view type)
+        {
+            out << "{\"name\": \"" << prefix;
+            detail::writeJsonEscaped(out, type);
+            out << "\"";
+        };
+
+        out << "{\"traceEvents\": [";
+        const char *separator = "\n";
+        forEach([&](const TraceEvent &e)
+                {
+                    out << separator;
+                    name("", e.type);
+                    out << ", \"cat\": \"lifetime\", \"ph\": \"b\", \"id\": \""
+                        << std::hex << "0x" << e.object << std::dec << "\", \"pid\": 1, \"tid\": " << e.bornThread
+                        << ", \"ts\": " << micros(e.born) << "},\n";
+                    name("", e.type);
+                    out << ", \"cat\": \"lifetime\", \"ph\": \"e\", \"id\": \""
+                        << std::hex << "0x" << e.object << std::dec << "\", \"pid\": 1, \"tid\": " << e.thread
+                        << ", \"ts\": " << micros(e.freeBegin) << "},\n";
+                    name("~", e.type);
+                    out << ", \"cat\": \"destroy\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                        << e.thread << ", \"ts\": " << micros(e.freeBegin)
+                        << ", \"dur\": " << micros(e.freeEnd - e.freeBegin) << "}";
+                    separator = ",\n";
+                });
+        out << "\n], \"displayTimeUnit\": \"ns\"}\n";
+    }
+
+    void writeChromeTrace(const std::filesystem::path &path) const
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            throw std::system_error(errno, std::generic_category(), "open " + path.string());
+        }
+        writeChromeTrace(out);
+    }
+};
+
+// Wraps any deleter and records when and where each object was adopted and how
+// long its deletion took into TraceBuffer::instance(). UniquePtr stamps the
+// adoption on construction from a pointer and on every reset to a new one.
+template <typename D>
+struct TracingDeleter
+{
+    [[no_unique_address]] D m_inner;
+    std::uint64_t m_born = 0;
+    std::uint32_t m_bornThread = 0;
+
+    TracingDeleter() = default;
+
+    explicit TracingDeleter(D inner) : m_inner(std::move(inner)) {}
+
+    // Follows converting moves of the wrapped deleter, keeping the creation time
+    template <typename E>
+        requires(!std::is_same_v<D, E> && std::is_constructible_v<D, const E &>)
+    TracingDeleter(const TracingDeleter<E> &other)
+        : m_inner(other.m_inner), m_born(other.m_born), m_bornThread(other.m_bornThread)
+    {
+    }
+
+    template <typename T>
+    void adopted(T *) noexcept
+    {
+        m_born = TraceBuffer::now();
+        m_bornThread = TraceBuffer::threadId();
+    }
+
+    template <typename T>
+    void operator()(T *m_ptr) noexcept(noexcept(m_inner(m_ptr)))
+    {
+        static constexpr std::string_view kType = type_name<T>();
+
+        const std::uint64_t begin = TraceBuffer::now();
+        m_inner(m_ptr);
+        TraceBuffer::instance().record(&kType, m_ptr, m_born, m_bornThread, begin, TraceBuffer::now());
+    }
+};
+
+template <typename T, typename... Args>
+    requires(!std::is_array_v<T>)
+UniquePtr<T, TracingDeleter<DefaultDeleter<T>>> make_traced_unique(Args &&...args)
+{
+    return UniquePtr<T, TracingDeleter<DefaultDeleter<T>>>(new T(std::forward<Args>(args)...));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+namespace detail
+{
+    template <typename T>
+    constexpr std::string_view rawTypeName() noexcept
+    {
+#if defined(__clang__) || defined(__GNUC__)
+        return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+        return __FUNCSIG__;
+#else
+        return {};
+#endif
+    }
+
+    // The signature of rawTypeName<int>() tells us where the name sits in the string
+    inline constexpr std::string_view kProbeName = rawTypeName<int>();
+    inline constexpr std::size_t kNamePrefix = kProbeName.find("int");
+    inline constexpr std::size_t kNameSuffix = kProbeName.size() - kNamePrefix - std::string_view("int").size();
+
+    // Writes name as the contents of a JSON string; compiler spellings may hold quotes or backslashes
+    inline void writeJsonEscaped(std::ostream &out, std::string_view name)
+    {
+        static constexpr char kHex[] = "0123456789abcdef";
+        for (const char c : name)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << "\\u00" << kHex[(c >> 4) & 0xf] << kHex[c & 0xf];
+            }
+            else
+            {
+                out << c;
+            }
+        }
+    }
+}
+
+// Human-readable name of T as spelled by the compiler, e.g. "std::vector<int>".
+// Compilers differ in spelling details; an unsupported compiler yields "".
+template <typename T>
+constexpr std::string_view type_name() noexcept
+{
+    constexpr std::string_view raw = detail::rawTypeName<T>();
+    if constexpr (detail::kNamePrefix == std::string_view::npos || raw.size() < detail::kProbeName.size())
+    {
+        return {};
+    }
+    else
+    {
+        return raw.substr(detail::kNamePrefix, raw.size() - detail::kNamePrefix - detail::kNameSuffix);
+    }
+}
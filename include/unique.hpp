@@ -1,12 +1,69 @@
+#pragma once
+
+#include <cstddef>
 #include <iostream>
+#include <new>
+#include <type_traits>
 #include <utility>
 
+#include "instrumentation.hpp"
+
+namespace detail
+{
+    // Any class-specific operator delete, including C++20 destroying delete
+    template <typename T>
+    concept HasClassDelete = requires(void *raw) { T::operator delete(raw); } ||
+                             requires(void *raw, std::size_t n) { T::operator delete(raw, n); } ||
+                             requires(void *raw) { T::operator delete(raw, std::align_val_t{}); } ||
+                             requires(T *p) { T::operator delete(p, std::destroying_delete); };
+
+    // The static type is the dynamic type and delete would reach the global operator,
+    // so the size and alignment are known at compile time
+    template <typename T>
+    inline constexpr bool kSizedDelete = !std::is_polymorphic_v<T> && !HasClassDelete<T>;
+
+    // Deleters told whenever their owner adopts a new object, e.g. to timestamp it
+    template <typename D, typename T>
+    concept AdoptionAware = requires(D &d, T *p) { d.adopted(p); };
+}
+
 template <typename T>
 struct DefaultDeleter
 {
+    DefaultDeleter() = default;
+
+    // Lets UniquePtr<Derived> convert to UniquePtr<Base>
+    template <typename U>
+        requires std::is_convertible_v<U *, T *>
+    DefaultDeleter(const DefaultDeleter<U> &) noexcept
+    {
+    }
+
+    // Passes the size (and alignment) to the global operator delete, so size-class
+    // allocators can skip the lookup even when the compiler does not do it for delete.
+    // Polymorphic types and types with their own operator delete go through delete,
+    // which finds the dynamic size or the class's (possibly destroying) operator.
     void operator()(T *m_ptr) const noexcept
     {
-        delete m_ptr;
+        static_assert(sizeof(T) > 0, "cannot delete an incomplete type");
+
+        if constexpr (detail::kSizedDelete<T>)
+        {
+            m_ptr->~T();
+            void *raw = const_cast<std::remove_cv_t<T> *>(m_ptr);
+            if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            {
+                ::operator delete(raw, sizeof(T), std::align_val_t(alignof(T)));
+            }
+            else
+            {
+                ::operator delete(raw, sizeof(T));
+            }
+        }
+        else
+        {
+            delete m_ptr;
+        }
     }
 };
 
@@ -19,18 +76,55 @@ struct DefaultDeleter<T[]>
     }
 };
 
+// Calls a fixed function such as FnDeleter<&fclose>. The function is part of the
+// type, so nothing is stored and the call can be inlined.
+template <auto Fn>
+struct FnDeleter
+{
+    template <typename T>
+    void operator()(T *m_ptr) const noexcept(noexcept(Fn(m_ptr)))
+    {
+        Fn(m_ptr);
+    }
+};
+
+namespace detail
+{
+    struct UniqueCast;
+}
+
 template <typename T, typename Deleter = DefaultDeleter<T>>
 class UniquePtr
 {
 private:
+    template <typename U, typename E>
+    friend class UniquePtr;
+    friend struct detail::UniqueCast;
+
     T *m_ptr;
     [[no_unique_address]] Deleter m_deleter;
+    // Empty unless UNIQUE_PTR_INSTRUMENTATION is defined
+    [[no_unique_address]] detail::LifetimeProbe<T> m_probe;
 
 private:
     void swap(UniquePtr &other) noexcept
     {
         std::swap(m_ptr, other.m_ptr);
         std::swap(m_deleter, other.m_deleter);
+        std::swap(m_probe, other.m_probe);
+    }
+
+    // p was just adopted from a raw pointer; moves and casts hand over existing state instead
+    void adopted(T *p) noexcept
+    {
+        m_probe.acquire(p);
+        if constexpr (detail::AdoptionAware<Deleter, T>)
+        {
+            if (p)
+            {
+                m_deleter.adopted(p);
+            }
+        }
     }
 
 public:
@@ -38,16 +132,18 @@ public:
     // explicit prevents implicit conversions
     explicit UniquePtr(T *p = nullptr) : m_ptr(p), m_deleter()
     {
+        adopted(p);
     }
 
-    UniquePtr(T *p, const Deleter &d) : m_ptr(p), m_deleter(d) {}
-    UniquePtr(T *p, Deleter &&d) : m_ptr(p), m_deleter(std::move(d)) {}
+    UniquePtr(T *p, const Deleter &d) : m_ptr(p), m_deleter(d) { adopted(p); }
+    UniquePtr(T *p, Deleter &&d) : m_ptr(p), m_deleter(std::move(d)) { adopted(p); }
 
     // Destructor
     ~UniquePtr()
     {
         if (m_ptr)
         {
+            m_probe.release(m_ptr);
             m_deleter(m_ptr);
         }
     }
@@ -57,7 +153,8 @@ public:
     UniquePtr &operator=(const UniquePtr &) = delete;
 
     // Move semantics
-    UniquePtr(UniquePtr &&other) noexcept : m_ptr(std::exchange(other.m_ptr, nullptr)), m_deleter(std::move(other.m_deleter))
+    UniquePtr(UniquePtr &&other) noexcept
+        : m_ptr(std::exchange(other.m_ptr, nullptr)), m_deleter(std::move(other.m_deleter)), m_probe(other.m_probe)
     {
     }
 
@@ -65,9 +162,41 @@ public:
     {
         if (this != &other)
         {
-            reset(other.release());
+            // Two distinct owners never share a pointer, so skip reset()'s equality check
+            T *old = std::exchange(m_ptr, std::exchange(other.m_ptr, nullptr));
+            if (old)
+            {
+                m_probe.release(old);
+                m_deleter(old);
+            }
             m_deleter = std::move(other.m_deleter);
+            m_probe = other.m_probe;
+        }
+        return *this;
+    }
+
+    // Converting moves, e.g. UniquePtr<Derived> into UniquePtr<Base>.
+    // Deleting through Base requires a virtual destructor, as with delete.
+    template <typename U, typename E>
+        requires(!std::is_array_v<U> && std::is_convertible_v<U *, T *> && std::is_constructible_v<Deleter, E &&>)
+    UniquePtr(UniquePtr<U, E> &&other) noexcept
+        : m_ptr(std::exchange(other.m_ptr, nullptr)), m_deleter(std::move(other.m_deleter))
+    {
+        m_probe.transfer(other.m_probe);
+    }
+
+    template <typename U, typename E>
+        requires(!std::is_array_v<U> && std::is_convertible_v<U *, T *> && std::is_assignable_v<Deleter &, E &&>)
+    UniquePtr &operator=(UniquePtr<U, E> &&other) noexcept
+    {
+        T *old = std::exchange(m_ptr, std::exchange(other.m_ptr, nullptr));
+        if (old)
+        {
+            m_probe.release(old);
+            m_deleter(old);
         }
+        m_deleter = std::move(other.m_deleter);
+        m_probe.transfer(other.m_probe);
         return *this;
     }
 
@@ -90,6 +219,7 @@ public:
     // Release ownership of raw pointer
     [[nodiscard]] T *release() noexcept
     {
+        m_probe.release(m_ptr);
         return std::exchange(m_ptr, nullptr);
     }
 
@@ -104,8 +234,10 @@ public:
         T *old = std::exchange(m_ptr, p);
         if (old)
         {
+            m_probe.release(old);
             m_deleter(old);
         }
+        adopted(p);
     }
 
     explicit operator bool() const noexcept
@@ -172,16 +304,28 @@ private:
         std::swap(m_deleter, other.m_deleter);
     }
 
+    void adopted(T *p) noexcept
+    {
+        if constexpr (detail::AdoptionAware<Deleter, T>)
+        {
+            if (p)
+            {
+                m_deleter.adopted(p);
+            }
+        }
+    }
+
 public:
     // Constructor
     // explicit prevents implicit conversions
     explicit UniquePtr(T *p = nullptr) : m_ptr(p), m_deleter()
     {
+        adopted(p);
     }
 
-    UniquePtr(T *p, const Deleter &d) : m_ptr(p), m_deleter(d) {}
+    UniquePtr(T *p, const Deleter &d) : m_ptr(p), m_deleter(d) { adopted(p); }
 
-    UniquePtr(T *p, Deleter &&d) : m_ptr(p), m_deleter(std::move(d)) {}
+    UniquePtr(T *p, Deleter &&d) : m_ptr(p), m_deleter(std::move(d)) { adopted(p); }
 
     // Destructor
     ~UniquePtr()
@@ -205,7 +349,12 @@ public:
     {
         if (this != &other)
         {
-            reset(other.release());
+            // Two distinct owners never share a pointer, so skip reset()'s equality check
+            T *old = std::exchange(m_ptr, other.release());
+            if (old)
+            {
+                m_deleter(old);
+            }
             m_deleter = std::move(other.m_deleter);
         }
         return *this;
@@ -239,6 +388,7 @@ public:
         if(old) {
             m_deleter(old);
         }
+        adopted(p);
     }
 
     explicit operator bool() const noexcept
@@ -296,6 +446,22 @@ public:
     }
 };
 
+// A type is trivially relocatable when moving it to new storage and destroying
+// the source is equivalent to copying its bytes, so containers may memcpy it
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// UniquePtr is a pointer plus its deleter, so it relocates trivially whenever the deleter does
+template <typename T, typename Deleter>
+struct is_trivially_relocatable<UniquePtr<T, Deleter>> : is_trivially_relocatable<Deleter>
+{
+};
+
 template <typename T, typename... Args>
 UniquePtr<T> make_unique(Args &&...args)
 {
@@ -306,4 +472,288 @@ template <typename T>
 UniquePtr<T[]> make_unique(size_t size)
 {
     return UniquePtr<T[]>(new T[size]);
-}
\ No newline at end of file
+}
+
+// Default-initialising factories: trivially constructible objects are left
+// uninitialised, so large buffers that are about to be overwritten are not zeroed first
+template <typename T>
+    requires(!std::is_array_v<T>)
+UniquePtr<T> make_unique_for_overwrite()
+{
+    return UniquePtr<T>(new T);
+}
+
+template <typename T>
+    requires std::is_unbounded_array_v<T>
+UniquePtr<T> make_unique_for_overwrite(size_t size)
+{
+    return UniquePtr<T>(new std::remove_extent_t<T>[size]);
+}
+
+namespace detail
+{
+    // DefaultDeleter follows the cast; any other deleter is carried over unchanged
+    template <typename T, typename Deleter>
+    struct CastDeleter
+    {
+        using type = Deleter;
+    };
+
+    template <typename T, typename U>
+    struct CastDeleter<T, DefaultDeleter<U>>
+    {
+        using type = DefaultDeleter<T>;
+    };
+
+    template <typename T, typename Deleter>
+    using CastDeleterT = typename CastDeleter<T, Deleter>::type;
+
+    // Hands p's object to an owner of another type as target, without ending
+    // and restarting its instrumented lifetime
+    struct UniqueCast
+    {
+        template <typename T, typename U, typename Deleter>
+        static UniquePtr<T, CastDeleterT<T, Deleter>> recast(UniquePtr<U, Deleter> &p, T *target) noexcept
+        {
+            if constexpr (std::is_same_v<CastDeleterT<T, Deleter>, Deleter>)
+            {
+                UniquePtr<T, Deleter> result(nullptr, std::move(p.m_deleter));
+                adopt(result, p, target);
+                return result;
+            }
+            else
+            {
+                UniquePtr<T, CastDeleterT<T, Deleter>> result;
+                adopt(result, p, target);
+                return result;
+            }
+        }
+
+    private:
+        template <typename T, typename D, typename U, typename E>
+        static void adopt(UniquePtr<T, D> &result, UniquePtr<U, E> &p, T *target) noexcept
+        {
+            result.m_ptr = target;
+            result.m_probe.transfer(p.m_probe);
+            p.m_ptr = nullptr;
+        }
+    };
+}
+
+// Transfers ownership with a static_cast, typically from a base to a known derived type
+template <typename T, typename U, typename Deleter>
+    requires(!std::is_array_v<T> && !std::is_array_v<U>)
+UniquePtr<T, detail::CastDeleterT<T, Deleter>> static_unique_cast(UniquePtr<U, Deleter> &&p) noexcept
+{
+    return detail::UniqueCast::recast(p, static_cast<T *>(p.get()));
+}
+
+// Transfers ownership only if the dynamic_cast succeeds.
+// On failure the result is empty and p still owns the object.
+template <typename T, typename U, typename Deleter>
+    requires(!std::is_array_v<T> && std::is_polymorphic_v<U>)
+UniquePtr<T, detail::CastDeleterT<T, Deleter>> dynamic_unique_cast(UniquePtr<U, Deleter> &&p) noexcept
+{
+    T *target = dynamic_cast<T *>(p.get());
+    if (!target)
+    {
+        return UniquePtr<T, detail::CastDeleterT<T, Deleter>>();
+    }
+    return detail::UniqueCast::recast(p, target);
+}
+
+// Unique owner of a polymorphic object that lives inside the pointer itself
+// when it fits in N bytes, falling back to the heap otherwise.
+// Moving an inline object relocates it (move-construct + destroy), so only
+// nothrow-move-constructible types are stored inline.
+template <typename Base, std::size_t N = 64>
+class InlineUniquePtr
+{
+private:
+    struct Ops
+    {
+        void (*m_destroy)(Base *) noexcept;
+        // Null for heap objects, which move by pointer
+        Base *(*m_relocate)(void *dst, Base *src) noexcept;
+    };
+
+    template <typename Derived>
+    static void destroyInline(Base *p) noexcept
+    {
+        static_cast<Derived *>(p)->~Derived();
+    }
+
+    template <typename Derived>
+    static void destroyHeap(Base *p) noexcept
+    {
+        delete static_cast<Derived *>(p);
+    }
+
+    template <typename Derived>
+    static Base *relocateInline(void *dst, Base *src) noexcept
+    {
+        Derived *from = static_cast<Derived *>(src);
+        Derived *to = new (dst) Derived(std::move(*from));
+        from->~Derived();
+        return to;
+    }
+
+    template <typename Derived>
+    static constexpr Ops kInlineOps{&destroyInline<Derived>, &relocateInline<Derived>};
+
+    template <typename Derived>
+    static constexpr Ops kHeapOps{&destroyHeap<Derived>, nullptr};
+
+    template <typename Derived>
+    static constexpr bool fitsInline = sizeof(Derived) <= N &&
+                                       alignof(Derived) <= alignof(std::max_align_t) &&
+                                       std::is_nothrow_move_constructible_v<Derived>;
+
+    alignas(std::max_align_t) unsigned char m_storage[N];
+    Base *m_ptr;
+    const Ops *m_ops;
+
+private:
+    void stealFrom(InlineUniquePtr &other) noexcept
+    {
+        if (other.m_ptr && other.m_ops->m_relocate)
+        {
+            m_ptr = other.m_ops->m_relocate(m_storage, other.m_ptr);
+        }
+        else
+        {
+            m_ptr = other.m_ptr;
+        }
+        m_ops = other.m_ops;
+
+        other.m_ptr = nullptr;
+        other.m_ops = nullptr;
+    }
+
+public:
+    InlineUniquePtr() noexcept : m_ptr(nullptr), m_ops(nullptr) {}
+    InlineUniquePtr(std::nullptr_t) noexcept : InlineUniquePtr() {}
+
+    ~InlineUniquePtr()
+    {
+        reset();
+    }
+
+    // Not copyable
+    InlineUniquePtr(const InlineUniquePtr &) = delete;
+    InlineUniquePtr &operator=(const InlineUniquePtr &) = delete;
+
+    // Move semantics
+    InlineUniquePtr(InlineUniquePtr &&other) noexcept
+    {
+        stealFrom(other);
+    }
+
+    InlineUniquePtr &operator=(InlineUniquePtr &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Replace managed object with a Derived built from args
+    template <typename Derived, typename... Args>
+    Derived &emplace(Args &&...args)
+    {
+        static_assert(std::is_base_of_v<Base, Derived>, "Derived must derive from Base");
+
+        reset();
+
+        Derived *object;
+        if constexpr (fitsInline<Derived>)
+        {
+            object = new (m_storage) Derived(std::forward<Args>(args)...);
+            m_ops = &kInlineOps<Derived>;
+        }
+        else
+        {
+            object = new Derived(std::forward<Args>(args)...);
+            m_ops = &kHeapOps<Derived>;
+        }
+        m_ptr = object;
+        return *object;
+    }
+
+    [[nodiscard]] Base &operator*() const noexcept
+    {
+        return *m_ptr;
+    }
+
+    [[nodiscard]] Base *operator->() const noexcept
+    {
+        return m_ptr;
+    }
+
+public:
+    [[nodiscard]] Base *get() const noexcept { return m_ptr; }
+
+    // True when the managed object lives in the internal buffer
+    [[nodiscard]] bool isInline() const noexcept
+    {
+        return m_ptr && m_ops->m_relocate;
+    }
+
+    // Destroy managed object
+    void reset() noexcept
+    {
+        if (m_ptr)
+        {
+            m_ops->m_destroy(std::exchange(m_ptr, nullptr));
+            m_ops = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_ptr != nullptr;
+    }
+
+    InlineUniquePtr &operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    friend void swap(InlineUniquePtr &a, InlineUniquePtr &b) noexcept
+    {
+        InlineUniquePtr tmp(std::move(a));
+        a = std::move(b);
+        b = std::move(tmp);
+    }
+
+    friend bool operator==(const InlineUniquePtr &a, std::nullptr_t) noexcept
+    {
+        return a.get() == nullptr;
+    }
+
+    friend bool operator==(std::nullptr_t, const InlineUniquePtr &b) noexcept
+    {
+        return b.get() == nullptr;
+    }
+
+    friend bool operator!=(const InlineUniquePtr &a, std::nullptr_t) noexcept
+    {
+        return a.get() != nullptr;
+    }
+
+    friend bool operator!=(std::nullptr_t, const InlineUniquePtr &b) noexcept
+    {
+        return b.get() != nullptr;
+    }
+};
+
+template <typename Base, typename Derived, std::size_t N = 64, typename... Args>
+InlineUniquePtr<Base, N> make_inline_unique(Args &&...args)
+{
+    InlineUniquePtr<Base, N> p;
+    p.template emplace<Derived>(std::forward<Args>(args)...);
+    return p;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include "unique.hpp"
+
+// Owning array that remembers its length.
+// Usable directly with range-based for, std::ranges and parallel algorithms.
+// operator[] is bounds-checked by assert, so the check vanishes under NDEBUG.
+template <typename T, typename Deleter = DefaultDeleter<T[]>>
+class UniqueArray
+{
+private:
+    UniquePtr<T[], Deleter> m_data;
+    std::size_t m_size;
+
+private:
+    void swap(UniqueArray &other) noexcept
+    {
+        using std::swap;
+        swap(m_data, other.m_data);
+        swap(m_size, other.m_size);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    UniqueArray() noexcept : m_data(), m_size(0) {}
+
+    UniqueArray(T *p, std::size_t size) : m_data(p), m_size(p ? size : 0) {}
+
+    UniqueArray(T *p, std::size_t size, const Deleter &d) : m_data(p, d), m_size(p ? size : 0) {}
+    UniqueArray(T *p, std::size_t size, Deleter &&d) : m_data(p, std::move(d)), m_size(p ? size : 0) {}
+
+    // Adopts an existing array pointer whose length the caller knows
+    UniqueArray(UniquePtr<T[], Deleter> &&data, std::size_t size) noexcept
+        : m_data(std::move(data)), m_size(m_data ? size : 0)
+    {
+    }
+
+    // Not copyable
+    UniqueArray(const UniqueArray &) = delete;
+    UniqueArray &operator=(const UniqueArray &) = delete;
+
+    // Move semantics
+    UniqueArray(UniqueArray &&other) noexcept : m_data(std::move(other.m_data)), m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    UniqueArray &operator=(UniqueArray &&other) noexcept
+    {
+        if (this != &other)
+        {
+            m_data = std::move(other.m_data);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+public:
+    [[nodiscard]] T *data() noexcept { return m_data.get(); }
+    [[nodiscard]] const T *data() const noexcept { return m_data.get(); }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] Deleter &getDeleter() noexcept { return m_data.getDeleter(); }
+    [[nodiscard]] const Deleter &getDeleter() const noexcept { return m_data.getDeleter(); }
+
+    [[nodiscard]] iterator begin() noexcept { return data(); }
+    [[nodiscard]] iterator end() noexcept { return data() + m_size; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+    [[nodiscard]] const_iterator end() const noexcept { return data() + m_size; }
+
+    [[nodiscard]] std::span<T> as_span() noexcept { return {data(), m_size}; }
+    [[nodiscard]] std::span<const T> as_span() const noexcept { return {data(), m_size}; }
+
+    [[nodiscard]] T &operator[](std::size_t i) noexcept
+    {
+        assert(i < m_size && "UniqueArray index out of range");
+        return data()[i];
+    }
+
+    [[nodiscard]] const T &operator[](std::size_t i) const noexcept
+    {
+        assert(i < m_size && "UniqueArray index out of range");
+        return data()[i];
+    }
+
+    // Release ownership of raw pointer, forgetting the length
+    [[nodiscard]] T *release() noexcept
+    {
+        m_size = 0;
+        return m_data.release();
+    }
+
+    // Replace managed array with p of the given length
+    void reset(T *p = nullptr, std::size_t size = 0) noexcept
+    {
+        m_data.reset(p);
+        m_size = p ? size : 0;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(m_data);
+    }
+
+    friend void swap(UniqueArray &a, UniqueArray &b) noexcept
+    {
+        a.swap(b);
+    }
+};
+
+template <typename T>
+UniqueArray<T> make_unique_array(std::size_t size)
+{
+    return UniqueArray<T>(new T[size], size);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include "unique.hpp"
+
+// Traits describe a non-pointer resource:
+//   using Handle = ...;                       // e.g. int for a file descriptor
+//   static constexpr Handle invalid();        // sentinel meaning "owns nothing"
+//   void close(Handle) const noexcept;        // releases a valid handle
+template <typename Traits>
+concept HandleTraits = requires(const Traits &traits, typename Traits::Handle h) {
+    { Traits::invalid() } -> std::convertible_to<typename Traits::Handle>;
+    { traits.close(h) } noexcept;
+};
+
+// UniquePtr for resources that are not pointers.
+// The handle is stored by value, so a UniqueHandle is exactly the size of the
+// handle whenever the traits are empty.
+template <HandleTraits Traits>
+class UniqueHandle
+{
+public:
+    using Handle = typename Traits::Handle;
+
+private:
+    Handle m_handle;
+    [[no_unique_address]] Traits m_traits;
+
+private:
+    void swap(UniqueHandle &other) noexcept
+    {
+        std::swap(m_handle, other.m_handle);
+        std::swap(m_traits, other.m_traits);
+    }
+
+public:
+    UniqueHandle() noexcept : m_handle(Traits::invalid()), m_traits() {}
+
+    explicit UniqueHandle(Handle h) noexcept : m_handle(h), m_traits() {}
+
+    UniqueHandle(Handle h, const Traits &traits) : m_handle(h), m_traits(traits) {}
+    UniqueHandle(Handle h, Traits &&traits) : m_handle(h), m_traits(std::move(traits)) {}
+
+    ~UniqueHandle()
+    {
+        if (m_handle != Traits::invalid())
+        {
+            m_traits.close(m_handle);
+        }
+    }
+
+    // Not copyable
+    UniqueHandle(const UniqueHandle &) = delete;
+    UniqueHandle &operator=(const UniqueHandle &) = delete;
+
+    // Move semantics
+    UniqueHandle(UniqueHandle &&other) noexcept
+        : m_handle(std::exchange(other.m_handle, Traits::invalid())), m_traits(std::move(other.m_traits))
+    {
+    }
+
+    UniqueHandle &operator=(UniqueHandle &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset(other.release());
+            m_traits = std::move(other.m_traits);
+        }
+        return *this;
+    }
+
+public:
+    [[nodiscard]] Handle get() const noexcept { return m_handle; }
+    [[nodiscard]] Traits &getTraits() noexcept { return m_traits; }
+    [[nodiscard]] const Traits &getTraits() const noexcept { return m_traits; }
+
+    // The traits play the deleter's role; named as in UniquePtr for generic code
+    [[nodiscard]] Traits &getDeleter() noexcept { return m_traits; }
+    [[nodiscard]] const Traits &getDeleter() const noexcept { return m_traits; }
+
+    // Release ownership of the raw handle
+    [[nodiscard]] Handle release() noexcept
+    {
+        return std::exchange(m_handle, Traits::invalid());
+    }
+
+    // Replace managed handle with h
+    void reset(Handle h = Traits::invalid()) noexcept
+    {
+        if (h == m_handle)
+        {
+            return;
+        }
+
+        Handle old = std::exchange(m_handle, h);
+        if (old != Traits::invalid())
+        {
+            m_traits.close(old);
+        }
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_handle != Traits::invalid();
+    }
+
+    friend void swap(UniqueHandle &a, UniqueHandle &b) noexcept
+    {
+        a.swap(b);
+    }
+
+    friend bool operator==(const UniqueHandle &a, const UniqueHandle &b) noexcept
+    {
+        return a.get() == b.get();
+    }
+
+    friend bool operator!=(const UniqueHandle &a, const UniqueHandle &b) noexcept
+    {
+        return a.get() != b.get();
+    }
+};
+
+// A handle relocates trivially when both the raw handle and the traits do
+template <typename Traits>
+struct is_trivially_relocatable<UniqueHandle<Traits>>
+    : std::bool_constant<is_trivially_relocatable_v<typename Traits::Handle> && is_trivially_relocatable_v<Traits>>
+{
+};
+
+#if __has_include(<unistd.h>)
+// POSIX file descriptors, sockets, epoll and timer fds
+struct FdTraits
+{
+    using Handle = int;
+
+    static constexpr int invalid() noexcept { return -1; }
+
+    void close(int fd) const noexcept
+    {
+        ::close(fd);
+    }
+};
+
+using UniqueFd = UniqueHandle<FdTraits>;
+#endif
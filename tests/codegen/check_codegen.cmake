@@ -0,0 +1,76 @@
+# Usage: cmake -DCXX=<compiler> -DSOURCE=<probes.cpp> -DINCLUDE=<dir> -DOBJECT=<file.o> -DOBJDUMP=<path>
+#              -DBUDGETS=<probe=max,...> [-DNO_CALLS=<probe,...>] -P check_codegen.cmake
+# Compiles SOURCE with fixed flags, independent of the build's own flags, so
+# sanitizer or coverage instrumentation cannot skew the count. Fails when a probe
+# function contains more conditional branches than its budget, or when a probe
+# listed in NO_CALLS calls or tail-calls anything.
+
+cmake_minimum_required(VERSION 3.14)
+
+execute_process(
+  COMMAND ${CXX} -std=c++20 -O2 -fno-exceptions -I${INCLUDE} -c ${SOURCE} -o ${OBJECT}
+  RESULT_VARIABLE result)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "failed to compile ${SOURCE}")
+endif()
+
+execute_process(
+  COMMAND ${OBJDUMP} -dr --no-show-raw-insn ${OBJECT}
+  OUTPUT_VARIABLE disassembly
+  RESULT_VARIABLE result)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "objdump failed on ${OBJECT}")
+endif()
+
+string(REPLACE "\n" ";" lines "${disassembly}")
+string(REPLACE "," ";" budgets "${BUDGETS}")
+string(REPLACE "," ";" noCalls "${NO_CALLS}")
+
+set(failed FALSE)
+foreach(budget IN LISTS budgets)
+  string(REPLACE "=" ";" pair "${budget}")
+  list(GET pair 0 probe)
+  list(GET pair 1 limit)
+
+  set(inside FALSE)
+  set(found FALSE)
+  set(branches 0)
+  set(calls 0)
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <(.*)>:$")
+      if(CMAKE_MATCH_1 STREQUAL probe)
+        set(inside TRUE)
+        set(found TRUE)
+      else()
+        set(inside FALSE)
+      endif()
+    elseif(inside AND line MATCHES "R_X86_64_PLT32|\t(call|jmp) +\\*")
+      # Direct calls and tail calls show up as PLT relocations in an unlinked object
+      math(EXPR calls "${calls} + 1")
+    elseif(inside AND line MATCHES "\t(j[a-z]+) ")
+      # Unconditional jumps are free
+      if(NOT CMAKE_MATCH_1 STREQUAL "jmp")
+        math(EXPR branches "${branches} + 1")
+      endif()
+    endif()
+  endforeach()
+
+  if(NOT found)
+    message(SEND_ERROR "${probe}: not found in ${OBJECT}")
+    set(failed TRUE)
+  elseif(branches GREATER limit)
+    message(SEND_ERROR "${probe}: ${branches} conditional branches, budget is ${limit}")
+    set(failed TRUE)
+  elseif(probe IN_LIST noCalls AND calls GREATER 0)
+    message(SEND_ERROR "${probe}: ${calls} calls, expected the callee to be inlined")
+    set(failed TRUE)
+  else()
+    message(STATUS "${probe}: ${branches} conditional branches (budget ${limit}), ${calls} calls")
+  endif()
+endforeach()
+
+if(failed)
+  message(FATAL_ERROR "UniquePtr codegen regressed")
+endif()
@@ -0,0 +1,54 @@
+// Compiled at -O2 and disassembled by check_codegen.cmake.
+// Each probe is a single UniquePtr operation with an unmangled name so the
+// script can find it; the branch budget for each lives in tests/CMakeLists.txt.
+#include <new>
+#include <utility>
+#include "unique.hpp"
+
+namespace
+{
+    struct Counter
+    {
+        int m_live;
+    };
+
+    // Stands in for a C library's destroy function visible to the optimiser
+    inline void release_counter(Counter *c) noexcept
+    {
+        --c->m_live;
+    }
+}
+
+extern "C"
+{
+    void probe_move_construct(UniquePtr<int> *dst, UniquePtr<int> &src) noexcept
+    {
+        new (dst) UniquePtr<int>(std::move(src));
+    }
+
+    void probe_move_assign(UniquePtr<int> &a, UniquePtr<int> &b) noexcept
+    {
+        a = std::move(b);
+    }
+
+    void probe_swap(UniquePtr<int> &a, UniquePtr<int> &b) noexcept
+    {
+        swap(a, b);
+    }
+
+    void probe_destroy(UniquePtr<int> *p) noexcept
+    {
+        p->~UniquePtr();
+    }
+
+    void probe_array_move_assign(UniquePtr<int[]> &a, UniquePtr<int[]> &b) noexcept
+    {
+        a = std::move(b);
+    }
+
+    // FnDeleter should inline the destroy function: no call at all
+    void probe_fn_deleter_destroy(UniquePtr<Counter, FnDeleter<&release_counter>> *p) noexcept
+    {
+        p->~UniquePtr();
+    }
+}
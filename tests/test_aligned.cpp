@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include "aligned.hpp"
+
+namespace
+{
+    bool isAligned(const void *p, std::size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    }
+}
+
+TEST(AlignedTest, AlignedPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(UniquePtr<float[], AlignedDeleter<float[]>>), sizeof(float *));
+}
+
+TEST(AlignedTest, HonoursRequestedAlignment)
+{
+    for (std::size_t alignment : {16u, 32u, 64u, 4096u})
+    {
+        auto buffer = make_unique_aligned<float[]>(1000, alignment);
+        EXPECT_EQ(buffer != nullptr, true);
+        EXPECT_EQ(isAligned(buffer.get(), alignment), true);
+    }
+}
+
+TEST(AlignedTest, ElementsAreWritable)
+{
+    constexpr std::size_t size = 1027;
+    auto buffer = make_unique_aligned<float[]>(size, 64);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        buffer[i] = static_cast<float>(i);
+    }
+    EXPECT_EQ(buffer[size - 1], static_cast<float>(size - 1));
+}
+
+TEST(AlignedTest, SmallAlignmentIsRaisedToElementAlignment)
+{
+    auto buffer = make_unique_aligned<double[]>(8, 1);
+    EXPECT_EQ(isAligned(buffer.get(), alignof(double)), true);
+}
+
+TEST(AlignedTest, RejectsNonPowerOfTwoAlignment)
+{
+    EXPECT_THROW(make_unique_aligned<float[]>(16, 48), std::invalid_argument);
+    EXPECT_THROW(make_unique_aligned<float[]>(16, 0), std::invalid_argument);
+}
+
+TEST(AlignedTest, EmptyBufferIsStillOwned)
+{
+    auto buffer = make_unique_aligned<float[]>(0, 64);
+    EXPECT_EQ(buffer != nullptr, true);
+}
+
+TEST(AlignedTest, HugeHintAlignsLargeBuffersToHugePages)
+{
+    const std::size_t size = kHugePageSize / sizeof(float) * 2;
+    auto buffer = make_unique_aligned<float[]>(size, 64, PageHint::Huge);
+
+    EXPECT_EQ(isAligned(buffer.get(), kHugePageSize), true);
+    buffer[0] = 1.0f;
+    buffer[size - 1] = 2.0f;
+    EXPECT_EQ(buffer[size - 1], 2.0f);
+}
+
+TEST(AlignedTest, HugeHintIgnoredForSmallBuffers)
+{
+    auto buffer = make_unique_aligned<float[]>(256, 64, PageHint::Huge);
+    EXPECT_EQ(isAligned(buffer.get(), 64), true);
+}
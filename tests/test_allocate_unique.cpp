@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include "allocate_unique.hpp"
+
+namespace
+{
+    struct AllocationLog
+    {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t liveBytes = 0;
+    };
+
+    // Stateless apart from a pointer to a shared log, like most tracking allocators
+    template <typename T>
+    struct TrackingAllocator
+    {
+        using value_type = T;
+
+        AllocationLog *m_log;
+
+        explicit TrackingAllocator(AllocationLog *log) : m_log(log) {}
+
+        template <typename U>
+        TrackingAllocator(const TrackingAllocator<U> &other) : m_log(other.m_log) {}
+
+        T *allocate(std::size_t n)
+        {
+            ++m_log->allocations;
+            m_log->liveBytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n)
+        {
+            ++m_log->deallocations;
+            m_log->liveBytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const TrackingAllocator &a, const TrackingAllocator &b) { return a.m_log == b.m_log; }
+    };
+
+    struct Counted
+    {
+        static inline int alive = 0;
+
+        int value;
+
+        explicit Counted(int v = 0) : value(v) { ++alive; }
+        ~Counted() { --alive; }
+    };
+
+    struct ThrowsOnThird
+    {
+        static inline int constructed = 0;
+
+        ThrowsOnThird()
+        {
+            if (++constructed == 3)
+            {
+                throw std::runtime_error("third");
+            }
+        }
+    };
+}
+
+static_assert(sizeof(UniquePtr<int, AllocatorDeleter<std::allocator<int>>>) == sizeof(int *));
+
+TEST(AllocateUniqueTest, StdAllocatorIsPointerSized)
+{
+    auto p = allocate_unique<int>(std::allocator<int>(), 42);
+
+    EXPECT_EQ(*p, 42);
+}
+
+TEST(AllocateUniqueTest, RoutesThroughTrackingAllocator)
+{
+    AllocationLog log;
+    {
+        // Rebound from char, as a caller with a generic allocator would pass it
+        auto p = allocate_unique<Counted>(TrackingAllocator<char>(&log), 7);
+
+        EXPECT_EQ(p->value, 7);
+        EXPECT_EQ(Counted::alive, 1);
+        EXPECT_EQ(log.allocations, 1u);
+        EXPECT_EQ(log.liveBytes, sizeof(Counted));
+    }
+
+    EXPECT_EQ(Counted::alive, 0);
+    EXPECT_EQ(log.deallocations, 1u);
+    EXPECT_EQ(log.liveBytes, 0u);
+}
+
+TEST(AllocateUniqueTest, ArrayCarriesCountToDeallocate)
+{
+    AllocationLog log;
+    {
+        auto p = allocate_unique<Counted[]>(TrackingAllocator<Counted>(&log), 5);
+
+        EXPECT_EQ(Counted::alive, 5);
+        EXPECT_EQ(p.getDeleter().m_count, 5u);
+        EXPECT_EQ(log.liveBytes, 5 * sizeof(Counted));
+    }
+
+    EXPECT_EQ(Counted::alive, 0);
+    EXPECT_EQ(log.liveBytes, 0u);
+}
+
+TEST(AllocateUniqueTest, ArrayConstructionFailureReleasesEverything)
+{
+    AllocationLog log;
+    ThrowsOnThird::constructed = 0;
+
+    EXPECT_THROW(allocate_unique<ThrowsOnThird[]>(TrackingAllocator<ThrowsOnThird>(&log), 4), std::runtime_error);
+
+    EXPECT_EQ(log.allocations, 1u);
+    EXPECT_EQ(log.deallocations, 1u);
+    EXPECT_EQ(log.liveBytes, 0u);
+}
+
+TEST(AllocateUniqueTest, AllocatesFromMonotonicBuffer)
+{
+    alignas(std::max_align_t) std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    auto p = allocate_unique<Counted>(std::pmr::polymorphic_allocator<>(&resource), 3);
+    auto q = allocate_unique<double[]>(std::pmr::polymorphic_allocator<>(&resource), 16);
+
+    EXPECT_GE(reinterpret_cast<std::byte *>(p.get()), buffer);
+    EXPECT_LT(reinterpret_cast<std::byte *>(p.get()), buffer + sizeof(buffer));
+    EXPECT_GE(reinterpret_cast<std::byte *>(q.get()), buffer);
+    EXPECT_EQ(q[15], 0.0);
+}
+
+TEST(AllocateUniqueTest, PmrOwnersMoveAssignAndSwap)
+{
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+    {
+        auto p = allocate_unique<Counted>(std::pmr::polymorphic_allocator<>(&first), 1);
+        auto q = allocate_unique<Counted>(std::pmr::polymorphic_allocator<>(&second), 2);
+
+        swap(p, q);
+        EXPECT_EQ(p->value, 2);
+        EXPECT_EQ(p.getDeleter().m_alloc.resource(), &second);
+        EXPECT_EQ(q.getDeleter().m_alloc.resource(), &first);
+
+        // q's object goes back to first, and p's deleter follows q's object
+        p = std::move(q);
+        EXPECT_EQ(p->value, 1);
+        EXPECT_EQ(p.getDeleter().m_alloc.resource(), &first);
+        EXPECT_EQ(Counted::alive, 1);
+    }
+
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(AllocateUniqueTest, PmrArrayOwnersMoveAssignAndSwap)
+{
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+    {
+        auto p = allocate_unique<Counted[]>(std::pmr::polymorphic_allocator<>(&first), 2);
+        auto q = allocate_unique<Counted[]>(std::pmr::polymorphic_allocator<>(&second), 3);
+
+        swap(p, q);
+        EXPECT_EQ(p.getDeleter().m_count, 3u);
+        EXPECT_EQ(p.getDeleter().m_alloc.resource(), &second);
+
+        p = std::move(q);
+        EXPECT_EQ(p.getDeleter().m_count, 2u);
+        EXPECT_EQ(p.getDeleter().m_alloc.resource(), &first);
+        EXPECT_EQ(Counted::alive, 2);
+    }
+
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(AllocateUniqueTest, ElementsReceivePoolAllocator)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+
+    auto strings = allocate_unique<std::pmr::string[]>(std::pmr::polymorphic_allocator<>(&pool), 3);
+    strings[0] = "a string long enough to leave the small buffer";
+
+    EXPECT_EQ(strings[0].get_allocator().resource(), &pool);
+    EXPECT_EQ(strings.getDeleter().m_alloc.resource(), &pool);
+}
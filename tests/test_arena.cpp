@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "arena.hpp"
+
+namespace
+{
+    struct Tracked
+    {
+        static inline int destroyed = 0;
+
+        std::string name;
+
+        explicit Tracked(std::string n) : name(std::move(n)) {}
+        ~Tracked() { ++destroyed; }
+    };
+
+    struct alignas(64) Wide
+    {
+        float lanes[16];
+    };
+}
+
+TEST(ArenaTest, ArenaPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(UniquePtr<int, ArenaDeleter>), sizeof(int *));
+}
+
+TEST(ArenaTest, ConstructInArena)
+{
+    Arena arena;
+    auto a = make_unique_in<int>(arena, 42);
+    auto b = make_unique_in<Tracked>(arena, "request");
+
+    EXPECT_EQ(*a, 42);
+    EXPECT_EQ(b->name, "request");
+}
+
+TEST(ArenaTest, DeleterRunsDestructorOnly)
+{
+    Tracked::destroyed = 0;
+    Arena arena;
+
+    {
+        auto p = make_unique_in<Tracked>(arena, "scoped");
+    }
+
+    EXPECT_EQ(Tracked::destroyed, 1);
+    EXPECT_GT(arena.bytesReserved(), 0u);
+}
+
+TEST(ArenaTest, RespectsAlignment)
+{
+    Arena arena;
+    auto byte = make_unique_in<char>(arena, 'x');
+    auto wide = make_unique_in<Wide>(arena);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide.get()) % alignof(Wide), 0u);
+}
+
+TEST(ArenaTest, GrowsAcrossBlocks)
+{
+    Arena arena(256);
+    std::vector<UniquePtr<std::uint64_t, ArenaDeleter>> values;
+
+    for (std::uint64_t i = 0; i < 500; ++i)
+    {
+        values.push_back(make_unique_in<std::uint64_t>(arena, i));
+    }
+
+    for (std::uint64_t i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(*values[i], i);
+    }
+    EXPECT_GE(arena.bytesReserved(), 500 * sizeof(std::uint64_t));
+}
+
+TEST(ArenaTest, OversizedAllocationGetsOwnBlock)
+{
+    Arena arena(64);
+    void *big = arena.allocate(4096);
+
+    EXPECT_NE(big, nullptr);
+    EXPECT_GE(arena.bytesReserved(), 4096u);
+}
+
+TEST(ArenaTest, ResetReclaimsMemory)
+{
+    Arena arena(1024);
+    int *first = nullptr;
+
+    {
+        auto p = make_unique_in<int>(arena, 1);
+        first = p.get();
+    }
+    arena.reset();
+
+    auto q = make_unique_in<int>(arena, 2);
+    EXPECT_EQ(q.get(), first);
+    EXPECT_EQ(*q, 2);
+}
+
+TEST(ArenaTest, ResetKeepsSingleBlock)
+{
+    Arena arena(128);
+    for (int i = 0; i < 100; ++i)
+    {
+        (void)arena.allocate(64);
+    }
+    EXPECT_GT(arena.bytesReserved(), 128u);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesReserved(), 128u);
+}
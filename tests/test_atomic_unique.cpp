@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "atomic_unique.hpp"
+
+namespace
+{
+    struct Item
+    {
+        static inline std::atomic<int> alive{0};
+
+        int id;
+
+        explicit Item(int i) : id(i) { ++alive; }
+        ~Item() { --alive; }
+    };
+
+    struct CountingDeleter
+    {
+        int *count;
+        void operator()(Item *p) const
+        {
+            ++*count;
+            delete p;
+        }
+    };
+}
+
+TEST(AtomicUniquePtrTest, IsPointerSizedWithStatelessDeleter)
+{
+    EXPECT_EQ(sizeof(AtomicUniquePtr<Item>), sizeof(Item *));
+    EXPECT_EQ(AtomicUniquePtr<Item>::is_always_lock_free, true);
+}
+
+TEST(AtomicUniquePtrTest, ExchangeReturnsPreviousOwner)
+{
+    AtomicUniquePtr<Item> slot(make_unique<Item>(1));
+
+    auto previous = slot.exchange(make_unique<Item>(2));
+    EXPECT_EQ(previous->id, 1);
+    EXPECT_EQ(slot.load()->id, 2);
+    EXPECT_EQ(Item::alive, 2);
+}
+
+TEST(AtomicUniquePtrTest, StoreDeletesDisplacedObject)
+{
+    int deleted = 0;
+    {
+        AtomicUniquePtr<Item, CountingDeleter> slot(CountingDeleter{&deleted});
+
+        slot.store(UniquePtr<Item, CountingDeleter>(new Item(1), CountingDeleter{&deleted}));
+        EXPECT_EQ(deleted, 0);
+
+        slot.store(UniquePtr<Item, CountingDeleter>(new Item(2), CountingDeleter{&deleted}));
+        EXPECT_EQ(deleted, 1);
+        EXPECT_EQ(slot.load()->id, 2);
+    }
+
+    EXPECT_EQ(deleted, 2);
+    EXPECT_EQ(Item::alive, 0);
+}
+
+TEST(AtomicUniquePtrTest, TakeEmptiesSlot)
+{
+    AtomicUniquePtr<Item> slot(make_unique<Item>(3));
+
+    auto taken = slot.take();
+    EXPECT_EQ(taken->id, 3);
+    EXPECT_EQ(static_cast<bool>(slot), false);
+    EXPECT_EQ(slot.take() == nullptr, true);
+}
+
+TEST(AtomicUniquePtrTest, CompareExchange)
+{
+    AtomicUniquePtr<Item> slot(make_unique<Item>(1));
+    Item *current = slot.load();
+
+    Item *stale = nullptr;
+    auto desired = make_unique<Item>(2);
+    EXPECT_EQ(slot.compare_exchange(stale, desired), false);
+    EXPECT_EQ(stale, current);
+    EXPECT_EQ(desired != nullptr, true);
+
+    EXPECT_EQ(slot.compare_exchange(stale, desired), true);
+    EXPECT_EQ(desired == nullptr, true);
+    EXPECT_EQ(slot.load()->id, 2);
+    EXPECT_EQ(Item::alive, 1);
+}
+
+TEST(AtomicUniquePtrTest, HandoffBetweenThreads)
+{
+    constexpr int count = 10000;
+    AtomicUniquePtr<Item> slot;
+    std::atomic<long> received{0};
+
+    std::thread consumer([&]
+                         {
+        int seen = 0;
+        while (seen < count)
+        {
+            if (auto item = slot.take())
+            {
+                received += item->id;
+                ++seen;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    for (int i = 1; i <= count; ++i)
+    {
+        auto item = make_unique<Item>(i);
+        Item *expected = nullptr;
+        while (!slot.compare_exchange(expected, item))
+        {
+            expected = nullptr;
+            std::this_thread::yield();
+        }
+    }
+
+    consumer.join();
+    EXPECT_EQ(received, static_cast<long>(count) * (count + 1) / 2);
+    EXPECT_EQ(Item::alive, 0);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include "batch.hpp"
+
+namespace
+{
+    struct Order
+    {
+        static inline std::atomic<int> alive{0};
+
+        std::string symbol;
+        int quantity;
+
+        Order(std::string s, int q) : symbol(std::move(s)), quantity(q) { ++alive; }
+        ~Order() { --alive; }
+    };
+
+    struct alignas(64) Line
+    {
+        char bytes[64];
+    };
+
+    struct ThrowsOnFourth
+    {
+        static inline int constructed = 0;
+        static inline std::atomic<int> alive{0};
+
+        ThrowsOnFourth()
+        {
+            if (++constructed == 4)
+            {
+                throw std::runtime_error("fourth");
+            }
+            ++alive;
+        }
+        ~ThrowsOnFourth() { --alive; }
+    };
+}
+
+TEST(BatchTest, ObjectsAreContiguousAndIndependent)
+{
+    {
+        auto orders = make_unique_batch<Order>(8, std::string("ABC"), 100);
+
+        ASSERT_EQ(orders.size(), 8u);
+        EXPECT_EQ(Order::alive, 8);
+        for (std::size_t i = 0; i + 1 < orders.size(); ++i)
+        {
+            EXPECT_EQ(orders[i].get() + 1, orders[i + 1].get());
+        }
+
+        orders[3]->quantity = 7;
+        EXPECT_EQ(orders[4]->quantity, 100);
+        EXPECT_EQ(orders[0]->symbol, "ABC");
+    }
+
+    EXPECT_EQ(Order::alive, 0);
+}
+
+TEST(BatchTest, SlabLivesUntilLastOwnerDies)
+{
+    auto orders = make_unique_batch<Order>(4, std::string("X"), 1);
+    Slab *slab = orders[0].getDeleter().m_slab;
+    EXPECT_EQ(slab->refs(), 4u);
+
+    // Keep one owner beyond the container
+    UniquePtr<Order, SlabDeleter<Order>> survivor = std::move(orders[2]);
+    orders.clear();
+
+    EXPECT_EQ(Order::alive, 1);
+    EXPECT_EQ(slab->refs(), 1u);
+    EXPECT_EQ(survivor->symbol, "X");
+
+    survivor.reset();
+    EXPECT_EQ(Order::alive, 0);
+}
+
+TEST(BatchTest, OwnersMayDieOnOtherThreads)
+{
+    auto orders = make_unique_batch<Order>(64, std::string("T"), 2);
+
+    std::thread worker([half = std::vector<UniquePtr<Order, SlabDeleter<Order>>>(
+                            std::make_move_iterator(orders.begin()), std::make_move_iterator(orders.begin() + 32))]() mutable
+                       { half.clear(); });
+    orders.erase(orders.begin(), orders.begin() + 32);
+    orders.clear();
+    worker.join();
+
+    EXPECT_EQ(Order::alive, 0);
+}
+
+TEST(BatchTest, OverAlignedObjects)
+{
+    auto lines = make_unique_batch<Line>(3);
+
+    for (const auto &line : lines)
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(line.get()) % 64, 0u);
+    }
+}
+
+TEST(BatchTest, EmptyBatchAllocatesNothing)
+{
+    auto none = make_unique_batch<Order>(0, std::string(), 0);
+
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(BatchTest, ConstructionFailureDestroysBuiltObjects)
+{
+    ThrowsOnFourth::constructed = 0;
+
+    EXPECT_THROW(make_unique_batch<ThrowsOnFourth>(6), std::runtime_error);
+
+    EXPECT_EQ(ThrowsOnFourth::alive, 0);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+#include "deferred.hpp"
+
+namespace
+{
+    std::atomic<bool> failAllocations{false};
+}
+
+// Lets tests make the batch's own allocations fail
+void *operator new(std::size_t size)
+{
+    if (failAllocations)
+    {
+        throw std::bad_alloc();
+    }
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    struct Tracked
+    {
+        static inline std::atomic<int> alive{0};
+
+        UniquePtr<Tracked, DeferredDeleter<Tracked>> child;
+
+        Tracked() { ++alive; }
+        ~Tracked() { --alive; }
+    };
+
+    using DeferredPtr = UniquePtr<Tracked, DeferredDeleter<Tracked>>;
+
+    bool waitUntil(const std::atomic<int> &value, int expected)
+    {
+        for (int i = 0; i < 500 && value != expected; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return value == expected;
+    }
+}
+
+TEST(DeferredTest, DeferredPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(DeferredPtr), sizeof(Tracked *));
+}
+
+TEST(DeferredTest, DestructionWaitsForQuiescentPoint)
+{
+    {
+        DeferredPtr p(new Tracked());
+    }
+    EXPECT_EQ(Tracked::alive, 1);
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, ResetDefersDisplacedObject)
+{
+    DeferredPtr p(new Tracked());
+    p.reset(new Tracked());
+    EXPECT_EQ(Tracked::alive, 2);
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 1);
+
+    p.reset();
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, FullBatchIsHandedToReclaimer)
+{
+    for (std::size_t i = 0; i < DeferredBatch::kFlushThreshold; ++i)
+    {
+        DeferredPtr p(new Tracked());
+    }
+
+    EXPECT_EQ(DeferredBatch::local().size(), 0u);
+    EXPECT_EQ(Reclaimer::instance().pending(), DeferredBatch::kFlushThreshold);
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, FailedFlushKeepsObjectsBatched)
+{
+    reclaim_deferred();
+
+    std::vector<Tracked *> objects;
+    for (std::size_t i = 0; i < DeferredBatch::kFlushThreshold; ++i)
+    {
+        objects.push_back(new Tracked());
+    }
+
+    // The last retire fills the batch and its flush cannot allocate
+    failAllocations = true;
+    for (Tracked *object : objects)
+    {
+        DeferredDeleter<Tracked>()(object);
+    }
+    failAllocations = false;
+
+    EXPECT_EQ(DeferredBatch::local().size(), DeferredBatch::kFlushThreshold);
+    EXPECT_EQ(Tracked::alive, static_cast<int>(DeferredBatch::kFlushThreshold));
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, NestedObjectsAreReclaimed)
+{
+    {
+        DeferredPtr root(new Tracked());
+        root->child.reset(new Tracked());
+        root->child->child.reset(new Tracked());
+    }
+    EXPECT_EQ(Tracked::alive, 3);
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, BackgroundThreadReclaimsFlushedBatches)
+{
+    Reclaimer::instance().start();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        DeferredPtr p(new Tracked());
+        p->child.reset(new Tracked());
+    }
+    DeferredBatch::local().flush();
+
+    EXPECT_EQ(waitUntil(Tracked::alive, 0), true);
+    Reclaimer::instance().stop();
+}
+
+TEST(DeferredTest, ExitingThreadFlushesItsBatch)
+{
+    std::thread worker([]
+                       { DeferredPtr p(new Tracked()); });
+    worker.join();
+
+    EXPECT_EQ(Reclaimer::instance().pending(), 1u);
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(DeferredTest, ArrayForm)
+{
+    {
+        UniquePtr<Tracked[], DeferredDeleter<Tracked[]>> p(new Tracked[4]);
+    }
+    EXPECT_EQ(Tracked::alive, 4);
+
+    reclaim_deferred();
+    EXPECT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "atomic_unique.hpp"
+#include "epoch.hpp"
+
+namespace
+{
+    struct Config
+    {
+        static inline std::atomic<int> alive{0};
+
+        int version;
+
+        explicit Config(int v) : version(v) { ++alive; }
+        ~Config() { --alive; }
+    };
+
+    // Destroying a link retires the rest of the chain into the same manager
+    struct Link
+    {
+        static inline std::atomic<int> alive{0};
+
+        UniquePtr<Link, EpochDeleter<Link>> next;
+
+        explicit Link(UniquePtr<Link, EpochDeleter<Link>> n) : next(std::move(n)) { ++alive; }
+        ~Link() { --alive; }
+    };
+}
+
+// Owners retire from their destructor and reset(), which must not throw
+static_assert(std::is_nothrow_invocable_v<EpochDeleter<Config>, Config *>);
+
+TEST(EpochTest, RetiredObjectSurvivesUntilCollected)
+{
+    EpochManager manager;
+    {
+        UniquePtr<Config, EpochDeleter<Config>> p(new Config(1), EpochDeleter<Config>{&manager});
+    }
+
+    EXPECT_EQ(Config::alive, 1);
+    EXPECT_EQ(manager.retired(), 1u);
+
+    EXPECT_EQ(manager.collect(), 1u);
+    EXPECT_EQ(Config::alive, 0);
+}
+
+TEST(EpochTest, PinnedReaderBlocksReclamation)
+{
+    EpochManager manager;
+    UniquePtr<Config, EpochDeleter<Config>> owner(new Config(1), EpochDeleter<Config>{&manager});
+
+    {
+        auto guard = manager.pin();
+        Config *seen = owner.get();
+
+        owner.reset(new Config(2));
+        manager.collect();
+
+        // Still safe to read inside the critical section
+        EXPECT_EQ(seen->version, 1);
+        EXPECT_EQ(Config::alive, 2);
+    }
+
+    manager.collect();
+    EXPECT_EQ(Config::alive, 1);
+}
+
+TEST(EpochTest, EpochAdvancesWhenNoReaderIsPinned)
+{
+    EpochManager manager;
+    const auto before = manager.epoch();
+
+    manager.collect();
+    EXPECT_GT(manager.epoch(), before);
+}
+
+TEST(EpochTest, ManagerDestructionFreesRetiredObjects)
+{
+    {
+        EpochManager manager;
+        EpochDeleter<Config>{&manager}(new Config(1));
+        EXPECT_EQ(Config::alive, 1);
+    }
+
+    EXPECT_EQ(Config::alive, 0);
+}
+
+TEST(EpochTest, ManagerDestructionFreesObjectsRetiredByDestructors)
+{
+    {
+        EpochManager manager;
+        UniquePtr<Link, EpochDeleter<Link>> head(nullptr, EpochDeleter<Link>{&manager});
+        for (int i = 0; i < 100; ++i)
+        {
+            head = UniquePtr<Link, EpochDeleter<Link>>(new Link(std::move(head)), EpochDeleter<Link>{&manager});
+        }
+        head.reset();
+        EXPECT_EQ(Link::alive, 100);
+    }
+
+    EXPECT_EQ(Link::alive, 0);
+}
+
+TEST(EpochTest, ConcurrentReadersAndWriter)
+{
+    EpochManager manager;
+    AtomicUniquePtr<Config, EpochDeleter<Config>> current(EpochDeleter<Config>{&manager});
+    current.store(UniquePtr<Config, EpochDeleter<Config>>(new Config(0), EpochDeleter<Config>{&manager}));
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&]
+                             {
+            int last = 0;
+            while (!done)
+            {
+                auto guard = manager.pin();
+                const Config *config = current.load();
+                // A freed object would be poisoned or reused, breaking monotonicity
+                if (config->version < last)
+                {
+                    failed = true;
+                }
+                last = config->version;
+            } });
+    }
+
+    for (int v = 1; v <= 5000; ++v)
+    {
+        current.store(UniquePtr<Config, EpochDeleter<Config>>(new Config(v), EpochDeleter<Config>{&manager}));
+    }
+
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failed, false);
+    manager.collect();
+    EXPECT_EQ(Config::alive, 1);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "hazard.hpp"
+
+namespace
+{
+    struct Settings
+    {
+        static inline std::atomic<int> alive{0};
+
+        int version;
+
+        explicit Settings(int v) : version(v) { ++alive; }
+        ~Settings() { --alive; }
+    };
+
+    using HazardPtr = UniquePtr<Settings, HazardDeleter<Settings>>;
+
+    // Destroying a link retires the rest of the chain into the same domain
+    struct Link
+    {
+        static inline std::atomic<int> alive{0};
+
+        UniquePtr<Link, HazardDeleter<Link>> next;
+
+        explicit Link(UniquePtr<Link, HazardDeleter<Link>> n) : next(std::move(n)) { ++alive; }
+        ~Link() { --alive; }
+    };
+}
+
+// Owners retire from their destructor and reset(), which must not throw
+static_assert(std::is_nothrow_invocable_v<HazardDeleter<Settings>, Settings *>);
+
+TEST(HazardTest, UnprotectedObjectIsReclaimed)
+{
+    HazardDomain domain;
+    {
+        HazardPtr p(new Settings(1), HazardDeleter<Settings>{&domain});
+    }
+
+    EXPECT_EQ(domain.retired(), 1u);
+    EXPECT_EQ(domain.reclaim(), 1u);
+    EXPECT_EQ(Settings::alive, 0);
+}
+
+TEST(HazardTest, ProtectedObjectSurvivesReset)
+{
+    HazardDomain domain;
+    AtomicUniquePtr<Settings, HazardDeleter<Settings>> current(HazardDeleter<Settings>{&domain});
+    current.store(HazardPtr(new Settings(1), HazardDeleter<Settings>{&domain}));
+
+    {
+        auto guard = domain.guard();
+        Settings *seen = guard.protect(current);
+
+        current.store(HazardPtr(new Settings(2), HazardDeleter<Settings>{&domain}));
+        EXPECT_EQ(domain.reclaim(), 0u);
+        EXPECT_EQ(seen->version, 1);
+    }
+
+    EXPECT_EQ(domain.reclaim(), 1u);
+    EXPECT_EQ(current.load()->version, 2);
+}
+
+TEST(HazardTest, GuardResetDropsProtection)
+{
+    HazardDomain domain;
+    std::atomic<Settings *> source{new Settings(1)};
+
+    auto guard = domain.guard();
+    Settings *seen = guard.protect(source);
+    HazardDeleter<Settings>{&domain}(seen);
+
+    EXPECT_EQ(domain.reclaim(), 0u);
+    guard.reset();
+    EXPECT_EQ(domain.reclaim(), 1u);
+    EXPECT_EQ(Settings::alive, 0);
+}
+
+TEST(HazardTest, RetireScansAutomatically)
+{
+    HazardDomain domain;
+    for (int i = 0; i < 1000; ++i)
+    {
+        HazardPtr p(new Settings(i), HazardDeleter<Settings>{&domain});
+    }
+
+    EXPECT_LT(domain.retired(), 100u);
+    domain.reclaim();
+    EXPECT_EQ(Settings::alive, 0);
+}
+
+TEST(HazardTest, DomainDestructionFreesObjectsRetiredByDestructors)
+{
+    {
+        HazardDomain domain;
+        UniquePtr<Link, HazardDeleter<Link>> head(nullptr, HazardDeleter<Link>{&domain});
+        for (int i = 0; i < 100; ++i)
+        {
+            head = UniquePtr<Link, HazardDeleter<Link>>(new Link(std::move(head)), HazardDeleter<Link>{&domain});
+        }
+
+        head.reset();
+        EXPECT_EQ(domain.retired(), 1u);
+        EXPECT_EQ(Link::alive, 100);
+    }
+
+    EXPECT_EQ(Link::alive, 0);
+}
+
+TEST(HazardTest, ConcurrentReadersAndWriter)
+{
+    HazardDomain domain;
+    AtomicUniquePtr<Settings, HazardDeleter<Settings>> current(HazardDeleter<Settings>{&domain});
+    current.store(HazardPtr(new Settings(0), HazardDeleter<Settings>{&domain}));
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&]
+                             {
+            auto guard = domain.guard();
+            int last = 0;
+            while (!done)
+            {
+                const Settings *settings = guard.protect(current);
+                if (settings->version < last)
+                {
+                    failed = true;
+                }
+                last = settings->version;
+            } });
+    }
+
+    for (int v = 1; v <= 5000; ++v)
+    {
+        current.store(HazardPtr(new Settings(v), HazardDeleter<Settings>{&domain}));
+    }
+
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failed, false);
+    domain.reclaim();
+    EXPECT_EQ(Settings::alive, 1);
+}
@@ -0,0 +1,182 @@
+// Instrumentation changes UniquePtr's layout, so this binary enables it for every
+// header it includes and must stay a separate test target.
+#define UNIQUE_PTR_INSTRUMENTATION
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include "unique.hpp"
+
+namespace
+{
+    template <int N>
+    struct Tracked
+    {
+        int m_values[N];
+    };
+
+    struct Shape
+    {
+        virtual ~Shape() = default;
+    };
+
+    struct Circle : Shape
+    {
+        double m_radius = 1.0;
+    };
+
+    template <typename T>
+    TypeStats statsFor()
+    {
+        const std::size_t id = Instrumentation::typeId<T>();
+        return Instrumentation::instance().snapshot().at(id);
+    }
+
+    template <typename T>
+    std::uint64_t histogramTotal()
+    {
+        const TypeStats stats = statsFor<T>();
+        return std::accumulate(stats.lifetimes.begin(), stats.lifetimes.end(), std::uint64_t{0});
+    }
+}
+
+// The probe now carries the adoption timestamp and type
+static_assert(sizeof(UniquePtr<int>) == sizeof(int *) + sizeof(std::uint64_t) + sizeof(std::size_t));
+
+TEST(InstrumentationTest, MakeUniqueAndDestructionAreCounted)
+{
+    using T = Tracked<1>;
+    {
+        auto p = make_unique<T>();
+        auto q = make_unique<T>();
+
+        const TypeStats stats = statsFor<T>();
+        EXPECT_EQ(stats.allocations, 2u);
+        EXPECT_EQ(stats.live(), 2);
+        EXPECT_EQ(stats.liveBytes(), static_cast<std::int64_t>(2 * sizeof(T)));
+        EXPECT_EQ(stats.size, sizeof(T));
+    }
+
+    const TypeStats stats = statsFor<T>();
+    EXPECT_EQ(stats.deallocations, 2u);
+    EXPECT_EQ(stats.live(), 0);
+    EXPECT_EQ(histogramTotal<T>(), 2u);
+}
+
+TEST(InstrumentationTest, ResetCountsOldAndNewObjects)
+{
+    using T = Tracked<2>;
+    auto p = make_unique<T>();
+
+    p.reset(new T());
+    p.reset();
+
+    const TypeStats stats = statsFor<T>();
+    EXPECT_EQ(stats.allocations, 2u);
+    EXPECT_EQ(stats.deallocations, 2u);
+}
+
+TEST(InstrumentationTest, MovesAreNotCounted)
+{
+    using T = Tracked<3>;
+    {
+        auto p = make_unique<T>();
+        UniquePtr<T> q(std::move(p));
+        UniquePtr<T> r;
+        r = std::move(q);
+        swap(p, r);
+    }
+
+    const TypeStats stats = statsFor<T>();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.deallocations, 1u);
+}
+
+TEST(InstrumentationTest, ConversionsKeepTheAdoptedType)
+{
+    {
+        UniquePtr<Shape> shape = make_unique<Circle>();
+        UniquePtr<Circle> circle = static_unique_cast<Circle>(std::move(shape));
+        shape = std::move(circle);
+        circle = dynamic_unique_cast<Circle>(std::move(shape));
+
+        EXPECT_EQ(statsFor<Circle>().allocations, 1u);
+        EXPECT_EQ(statsFor<Circle>().live(), 1);
+        EXPECT_EQ(statsFor<Shape>().allocations, 0u);
+    }
+
+    const TypeStats circles = statsFor<Circle>();
+    EXPECT_EQ(circles.deallocations, 1u);
+    EXPECT_EQ(circles.liveBytes(), 0);
+    EXPECT_EQ(histogramTotal<Circle>(), 1u);
+    EXPECT_EQ(statsFor<Shape>().deallocations, 0u);
+}
+
+TEST(InstrumentationTest, ReleaseEndsTracking)
+{
+    using T = Tracked<4>;
+    auto p = make_unique<T>();
+
+    T *raw = p.release();
+    EXPECT_EQ(statsFor<T>().live(), 0);
+
+    delete raw;
+}
+
+TEST(InstrumentationTest, ExitedThreadsAreKept)
+{
+    using T = Tracked<5>;
+
+    std::thread worker([]
+                       {
+                           for (int i = 0; i < 10; ++i)
+                           {
+                               auto p = make_unique<T>();
+                           }
+                       });
+    worker.join();
+
+    const TypeStats stats = statsFor<T>();
+    EXPECT_EQ(stats.allocations, 10u);
+    EXPECT_EQ(stats.deallocations, 10u);
+}
+
+TEST(InstrumentationTest, ObjectsMayDieOnAnotherThread)
+{
+    using T = Tracked<6>;
+    auto p = make_unique<T>();
+
+    std::thread worker([q = std::move(p)]() mutable { q.reset(); });
+    worker.join();
+
+    EXPECT_EQ(statsFor<T>().live(), 0);
+}
+
+TEST(InstrumentationTest, SnapshotExportsJson)
+{
+    using T = Tracked<7>;
+    auto p = make_unique<T>();
+
+    std::ostringstream out;
+    Instrumentation::instance().writeJson(out);
+
+    EXPECT_NE(out.str().find(std::string(type_name<T>())), std::string::npos);
+    EXPECT_NE(out.str().find("\"lifetimeLog2Ns\""), std::string::npos);
+}
+
+TEST(InstrumentationTest, JsonEscapesTypeNames)
+{
+    std::ostringstream out;
+    detail::writeJsonEscaped(out, "a\"b\\c\n");
+
+    EXPECT_EQ(out.str(), "a\\\"b\\\\c\\u000a");
+}
+
+TEST(TypeNameTest, SpellsTypes)
+{
+    EXPECT_EQ(type_name<int>(), "int");
+    EXPECT_NE(type_name<Tracked<1>>().find("Tracked<1>"), std::string_view::npos);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include "aligned.hpp"
+#include "arena.hpp"
+#include "numa.hpp"
+#include "pool.hpp"
+#include "recycle.hpp"
+#include "thread_cache.hpp"
+#include "unique.hpp"
+#include "unique_handle.hpp"
+
+// Layout guarantees: these fail the build, not the test run.
+namespace
+{
+    auto lambdaDeleter = [](int *p) { delete p; };
+    auto lambdaArrayDeleter = [](int *p) { delete[] p; };
+
+    struct Widget
+    {
+        virtual ~Widget() = default;
+        double m_value;
+    };
+}
+
+// Empty deleters must cost nothing
+static_assert(sizeof(UniquePtr<int>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<Widget>) == sizeof(Widget *));
+static_assert(sizeof(UniquePtr<int[]>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int, decltype(lambdaDeleter)>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int[], decltype(lambdaArrayDeleter)>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int, PoolDeleter<int>>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int, RecyclingDeleter<int>>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int, CachedDeleter<int>>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int, ArenaDeleter>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<int[], AlignedDeleter<int[]>>) == sizeof(int *));
+static_assert(sizeof(UniquePtr<std::FILE, FnDeleter<&fclose>>) == sizeof(std::FILE *));
+#if __has_include(<unistd.h>)
+static_assert(sizeof(UniqueFd) == sizeof(int));
+#endif
+
+// Stateful deleters cost exactly their state
+static_assert(sizeof(UniquePtr<int, NumaDeleter<int>>) == sizeof(int *) + sizeof(std::size_t));
+static_assert(sizeof(UniquePtr<std::FILE, void (*)(std::FILE *)>) == 2 * sizeof(void *));
+
+// Moves must stay cheap enough for containers to rely on them
+static_assert(std::is_nothrow_move_constructible_v<UniquePtr<int>>);
+static_assert(std::is_nothrow_move_assignable_v<UniquePtr<int>>);
+static_assert(std::is_nothrow_move_constructible_v<UniquePtr<int[]>>);
+static_assert(std::is_nothrow_move_assignable_v<UniquePtr<int[]>>);
+static_assert(std::is_nothrow_swappable_v<UniquePtr<int>>);
+static_assert(is_trivially_relocatable_v<UniquePtr<int>>);
+static_assert(is_trivially_relocatable_v<UniquePtr<int, decltype(lambdaDeleter)>>);
+
+// With an empty deleter the object representation is just the raw pointer
+TEST(LayoutTest, EmptyDeleterAddsNoStorage)
+{
+    UniquePtr<int, decltype(lambdaDeleter)> p(new int(3), lambdaDeleter);
+
+    int *raw = nullptr;
+    std::memcpy(&raw, &p, sizeof(raw));
+
+    EXPECT_EQ(raw, p.get());
+    EXPECT_EQ(*raw, 3);
+}
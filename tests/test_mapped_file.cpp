@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include "mapped_file.hpp"
+
+namespace
+{
+    // Temporary file removed at the end of each test
+    struct TempFile
+    {
+        std::filesystem::path path;
+
+        explicit TempFile(const std::string &contents)
+            : path(std::filesystem::temp_directory_path() /
+                   ("unique_ptr_mapped_" + std::to_string(::getpid()) + "_" +
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+        {
+            std::ofstream(path, std::ios::binary) << contents;
+        }
+
+        ~TempFile()
+        {
+            std::filesystem::remove(path);
+        }
+
+        std::string read() const
+        {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), {});
+        }
+    };
+
+    std::string view(const UniquePtr<std::byte[], MunmapDeleter> &map)
+    {
+        return std::string(reinterpret_cast<const char *>(map.get()), map.getDeleter().m_length);
+    }
+}
+
+TEST(MappedFileTest, MapsWholeFileReadOnly)
+{
+    TempFile file("hello mapped world");
+
+    auto map = map_file_unique(file.path);
+
+    ASSERT_NE(map.get(), nullptr);
+    EXPECT_EQ(map.getDeleter().m_length, 18u);
+    EXPECT_EQ(view(map), "hello mapped world");
+}
+
+TEST(MappedFileTest, ReadWriteWritesThrough)
+{
+    TempFile file("abcdef");
+
+    {
+        auto map = map_file_unique(file.path, MapMode::ReadWrite);
+        map[0] = std::byte{'X'};
+    }
+
+    EXPECT_EQ(file.read(), "Xbcdef");
+}
+
+TEST(MappedFileTest, CopyOnWriteLeavesFileUntouched)
+{
+    TempFile file("abcdef");
+
+    auto map = map_file_unique(file.path, MapMode::CopyOnWrite);
+    map[0] = std::byte{'X'};
+
+    EXPECT_EQ(view(map), "Xbcdef");
+    EXPECT_EQ(file.read(), "abcdef");
+}
+
+TEST(MappedFileTest, OptionsDoNotChangeContents)
+{
+    std::string contents(1 << 20, 'q');
+    TempFile file(contents);
+
+    auto map = map_file_unique(file.path, MapMode::ReadOnly, MapOptions{true, MapAdvice::Sequential});
+
+    EXPECT_EQ(view(map), contents);
+}
+
+TEST(MappedFileTest, EmptyFileYieldsNull)
+{
+    TempFile file("");
+
+    auto map = map_file_unique(file.path);
+
+    EXPECT_EQ(map.get(), nullptr);
+    EXPECT_EQ(map.getDeleter().m_length, 0u);
+}
+
+TEST(MappedFileTest, MissingFileThrows)
+{
+    EXPECT_THROW(map_file_unique("/nonexistent/unique_ptr_mapped"), std::system_error);
+}
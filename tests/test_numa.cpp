@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include "numa.hpp"
+
+namespace
+{
+    struct Buffer
+    {
+        static inline int alive = 0;
+
+        std::string name;
+        char bytes[8192];
+
+        explicit Buffer(std::string n) : name(std::move(n)) { ++alive; }
+        ~Buffer() { --alive; }
+    };
+
+    struct Cell
+    {
+        static inline int alive = 0;
+
+        Cell() { ++alive; }
+        ~Cell() { --alive; }
+    };
+}
+
+TEST(NumaTest, ScalarObjectIsPlacedOnRequestedNode)
+{
+    {
+        auto buffer = make_unique_on_node<Buffer>(0, "node0");
+
+        EXPECT_EQ(buffer->name, "node0");
+        EXPECT_EQ(Buffer::alive, 1);
+        EXPECT_EQ(numa_node_of(buffer.get()), 0);
+        EXPECT_EQ(buffer.getDeleter().m_length, sizeof(Buffer));
+    }
+
+    EXPECT_EQ(Buffer::alive, 0);
+}
+
+TEST(NumaTest, ArrayPagesArePlacedOnRequestedNode)
+{
+    constexpr std::size_t size = 1 << 20;
+    auto data = make_unique_on_node<char[]>(0, size);
+
+    // First touch of every page happens here
+    std::memset(data.get(), 1, size);
+
+    for (std::size_t offset = 0; offset < size; offset += 64 * 1024)
+    {
+        EXPECT_EQ(numa_node_of(data.get() + offset), 0);
+    }
+}
+
+TEST(NumaTest, ArrayElementsAreDestroyed)
+{
+    {
+        auto cells = make_unique_on_node<Cell[]>(0, 3);
+        EXPECT_EQ(Cell::alive, 3);
+        EXPECT_EQ(cells.getDeleter().m_count, 3u);
+    }
+
+    EXPECT_EQ(Cell::alive, 0);
+}
+
+TEST(NumaTest, UnknownNodeThrows)
+{
+    EXPECT_THROW(make_unique_on_node<int>(1000, 1), std::system_error);
+    EXPECT_THROW(make_unique_on_node<int>(-1, 1), std::system_error);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "pool.hpp"
+
+namespace
+{
+    struct Node
+    {
+        static inline int alive = 0;
+
+        int value;
+        Node *next = nullptr;
+
+        explicit Node(int v) : value(v) { ++alive; }
+        ~Node() { --alive; }
+    };
+
+    struct Message
+    {
+        int payload[4];
+    };
+
+    struct Throwing
+    {
+        Throwing() { throw std::runtime_error("constructor failed"); }
+    };
+}
+
+TEST(PoolTest, PooledPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(UniquePtr<Node, PoolDeleter<Node>>), sizeof(Node *));
+}
+
+TEST(PoolTest, ConstructAndDestroy)
+{
+    {
+        auto p = make_pooled_unique<Node>(42);
+        EXPECT_EQ(p->value, 42);
+        EXPECT_EQ(Node::alive, 1);
+    }
+
+    EXPECT_EQ(Node::alive, 0);
+}
+
+TEST(PoolTest, FreedSlotIsReused)
+{
+    Node *first = nullptr;
+    {
+        auto p = make_pooled_unique<Node>(1);
+        first = p.get();
+    }
+
+    auto q = make_pooled_unique<Node>(2);
+    EXPECT_EQ(q.get(), first);
+    EXPECT_EQ(q->value, 2);
+}
+
+TEST(PoolTest, ManyObjectsSpanSeveralSlabs)
+{
+    constexpr int count = 1000;
+    std::vector<UniquePtr<Node, PoolDeleter<Node>>> nodes;
+
+    for (int i = 0; i < count; ++i)
+    {
+        nodes.push_back(make_pooled_unique<Node>(i));
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(nodes[i]->value, i);
+    }
+    EXPECT_EQ(Node::alive, count);
+
+    nodes.clear();
+    EXPECT_EQ(Node::alive, 0);
+}
+
+TEST(PoolTest, ResetReturnsSlotToPool)
+{
+    auto p = make_pooled_unique<Node>(7);
+    Node *slot = p.get();
+
+    p.reset();
+    EXPECT_EQ(Node::alive, 0);
+
+    auto q = make_pooled_unique<Node>(8);
+    EXPECT_EQ(q.get(), slot);
+}
+
+TEST(PoolTest, FreeOnAnotherThread)
+{
+    auto p = make_pooled_unique<Node>(3);
+
+    std::thread worker([moved = std::move(p)]() mutable
+                       { moved.reset(); });
+    worker.join();
+
+    EXPECT_EQ(Node::alive, 0);
+
+    // Slots cached by the exited thread are reusable
+    auto q = make_pooled_unique<Node>(4);
+    EXPECT_EQ(q->value, 4);
+}
+
+TEST(PoolTest, ProducerConsumerReusesSlots)
+{
+    using Slabs = detail::PoolSlabs<Message>;
+    constexpr std::size_t batchSize = 4 * Slabs::kSlotsPerSlab;
+    constexpr int rounds = 50;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::vector<UniquePtr<Message, PoolDeleter<Message>>> inbox;
+    bool done = false;
+    std::size_t maxCached = 0;
+
+    // Only frees, so without spilling its free list would grow every round
+    std::thread consumer([&]
+                         {
+                             std::unique_lock<std::mutex> lock(mutex);
+                             while (!done)
+                             {
+                                 ready.wait(lock, [&] { return done || !inbox.empty(); });
+                                 inbox.clear();
+                                 maxCached = std::max(maxCached, ObjectPool<Message>::local().cachedSlots());
+                                 ready.notify_all();
+                             } });
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::vector<UniquePtr<Message, PoolDeleter<Message>>> batch;
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            batch.push_back(make_pooled_unique<Message>());
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        inbox = std::move(batch);
+        ready.notify_all();
+        ready.wait(lock, [&] { return inbox.empty(); });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_all();
+    consumer.join();
+
+    EXPECT_LT(maxCached, ObjectPool<Message>::kLocalCapacity);
+    // Live objects plus each thread's cap, not one batch per round
+    EXPECT_LE(Slabs::instance().slabCount(), 2 * batchSize / Slabs::kSlotsPerSlab);
+}
+
+TEST(PoolTest, ThrowingConstructorReleasesSlot)
+{
+    ObjectPool<Throwing> &pool = ObjectPool<Throwing>::local();
+    void *before = pool.allocate();
+    pool.deallocate(before);
+
+    EXPECT_THROW(make_pooled_unique<Throwing>(), std::runtime_error);
+
+    void *after = pool.allocate();
+    EXPECT_EQ(after, before);
+    pool.deallocate(after);
+}
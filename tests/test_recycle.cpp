@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "recycle.hpp"
+
+namespace
+{
+    struct Message
+    {
+        static inline int alive = 0;
+
+        std::string payload;
+
+        explicit Message(std::string p) : payload(std::move(p)) { ++alive; }
+        ~Message() { --alive; }
+    };
+
+    RecycleCache<Message> &cache()
+    {
+        return RecycleCache<Message>::local();
+    }
+
+    class RecycleTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            cache().setCapacity(0);
+            cache().setCapacity(RecycleCache<Message>::kDefaultCapacity);
+            cache().resetStats();
+        }
+    };
+}
+
+TEST_F(RecycleTest, RecycledPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(UniquePtr<Message, RecyclingDeleter<Message>>), sizeof(Message *));
+}
+
+TEST_F(RecycleTest, FirstAllocationMissesThenHits)
+{
+    Message *first = nullptr;
+    {
+        auto m = make_recycled<Message>("hello");
+        first = m.get();
+        EXPECT_EQ(m->payload, "hello");
+    }
+    EXPECT_EQ(Message::alive, 0);
+
+    auto again = make_recycled<Message>("world");
+    EXPECT_EQ(again.get(), first);
+    EXPECT_EQ(again->payload, "world");
+
+    EXPECT_EQ(cache().stats().misses, 1u);
+    EXPECT_EQ(cache().stats().hits, 1u);
+    EXPECT_EQ(cache().stats().recycled, 1u);
+}
+
+TEST_F(RecycleTest, CacheIsBounded)
+{
+    cache().setCapacity(4);
+    {
+        std::vector<UniquePtr<Message, RecyclingDeleter<Message>>> messages;
+        for (int i = 0; i < 10; ++i)
+        {
+            messages.push_back(make_recycled<Message>(std::to_string(i)));
+        }
+    }
+
+    EXPECT_EQ(cache().size(), 4u);
+    EXPECT_EQ(cache().stats().recycled, 4u);
+    EXPECT_EQ(cache().stats().released, 6u);
+}
+
+TEST_F(RecycleTest, ShrinkingCapacityFreesBlocks)
+{
+    {
+        auto a = make_recycled<Message>("a");
+        auto b = make_recycled<Message>("b");
+    }
+    EXPECT_EQ(cache().size(), 2u);
+
+    cache().setCapacity(1);
+    EXPECT_EQ(cache().size(), 1u);
+}
+
+TEST_F(RecycleTest, DestroyOnAnotherThread)
+{
+    auto m = make_recycled<Message>("cross");
+
+    std::thread worker([moved = std::move(m)]() mutable
+                       { moved.reset(); });
+    worker.join();
+
+    EXPECT_EQ(Message::alive, 0);
+    EXPECT_EQ(cache().stats().recycled, 0u);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include "relocate.hpp"
+
+namespace
+{
+    struct FunctionDeleter
+    {
+        std::function<void(int *)> m_fn;
+        void operator()(int *p) const { m_fn(p); }
+    };
+
+    struct Counted
+    {
+        static inline int alive = 0;
+
+        std::string name;
+
+        explicit Counted(std::string n) : name(std::move(n)) { ++alive; }
+        Counted(Counted &&other) noexcept : name(std::move(other.name)) { ++alive; }
+        ~Counted() { --alive; }
+    };
+
+    struct MaybeThrows
+    {
+        static inline int alive = 0;
+
+        explicit MaybeThrows(bool fail)
+        {
+            if (fail)
+            {
+                throw std::runtime_error("constructor failed");
+            }
+            ++alive;
+        }
+        MaybeThrows(MaybeThrows &&) noexcept { ++alive; }
+        ~MaybeThrows() { --alive; }
+    };
+}
+
+static_assert(is_trivially_relocatable_v<int *>);
+static_assert(is_trivially_relocatable_v<UniquePtr<int>>);
+static_assert(is_trivially_relocatable_v<UniquePtr<int[]>>);
+static_assert(!is_trivially_relocatable_v<UniquePtr<int, FunctionDeleter>>);
+static_assert(!is_trivially_relocatable_v<InlineUniquePtr<int>>);
+static_assert(!is_trivially_relocatable_v<Counted>);
+
+TEST(RelocateTest, RelocateTriviallyRelocatableRange)
+{
+    alignas(UniquePtr<int>) unsigned char from[2 * sizeof(UniquePtr<int>)];
+    alignas(UniquePtr<int>) unsigned char to[2 * sizeof(UniquePtr<int>)];
+
+    auto *src = reinterpret_cast<UniquePtr<int> *>(from);
+    auto *dst = reinterpret_cast<UniquePtr<int> *>(to);
+    std::construct_at(src, new int(1));
+    std::construct_at(src + 1, new int(2));
+
+    EXPECT_EQ(relocate(src, src + 2, dst), dst + 2);
+    EXPECT_EQ(*dst[0], 1);
+    EXPECT_EQ(*dst[1], 2);
+
+    std::destroy(dst, dst + 2);
+}
+
+TEST(RelocateTest, VectorOfUniquePtrGrows)
+{
+    RelocatingVector<UniquePtr<int>> v;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(make_unique<int>(i));
+    }
+
+    EXPECT_EQ(v.size(), 1000u);
+    EXPECT_GE(v.capacity(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(*v[i], i);
+    }
+}
+
+TEST(RelocateTest, VectorOfNonTrivialTypeMovesElements)
+{
+    {
+        RelocatingVector<Counted> v;
+        for (int i = 0; i < 50; ++i)
+        {
+            v.emplace_back("item" + std::to_string(i));
+        }
+
+        EXPECT_EQ(Counted::alive, 50);
+        EXPECT_EQ(v[49].name, "item49");
+        EXPECT_EQ(v[0].name, "item0");
+    }
+
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(RelocateTest, EmplaceFromOwnElementDuringGrowth)
+{
+    RelocatingVector<std::string> v;
+    v.emplace_back("first");
+    v.reserve(1);
+
+    while (v.size() < v.capacity())
+    {
+        v.emplace_back("filler");
+    }
+    v.emplace_back(v[0]);
+
+    EXPECT_EQ(v[v.size() - 1], "first");
+    EXPECT_EQ(v[0], "first");
+}
+
+TEST(RelocateTest, PopBackAndClearDestroyElements)
+{
+    RelocatingVector<Counted> v;
+    v.emplace_back("a");
+    v.emplace_back("b");
+    v.emplace_back("c");
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2u);
+    EXPECT_EQ(Counted::alive, 2);
+
+    v.clear();
+    EXPECT_EQ(v.empty(), true);
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(RelocateTest, ThrowingConstructorLeavesSizeUnchanged)
+{
+    {
+        RelocatingVector<MaybeThrows> v;
+        v.reserve(4);
+        v.emplace_back(false);
+
+        // Spare capacity: constructed in place
+        EXPECT_THROW(v.emplace_back(true), std::runtime_error);
+        EXPECT_EQ(v.size(), 1u);
+
+        v.emplace_back(false);
+        v.emplace_back(false);
+        v.emplace_back(false);
+
+        // Full: constructed in the grown buffer
+        EXPECT_THROW(v.emplace_back(true), std::runtime_error);
+        EXPECT_EQ(v.size(), 4u);
+        EXPECT_EQ(MaybeThrows::alive, 4);
+    }
+
+    EXPECT_EQ(MaybeThrows::alive, 0);
+}
+
+TEST(RelocateTest, MoveVector)
+{
+    RelocatingVector<UniquePtr<int>> a;
+    a.push_back(make_unique<int>(5));
+
+    RelocatingVector<UniquePtr<int>> b(std::move(a));
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(*b[0], 5);
+
+    a = std::move(b);
+    EXPECT_EQ(*a[0], 5);
+    EXPECT_EQ(b.empty(), true);
+}
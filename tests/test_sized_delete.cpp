@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "unique.hpp"
+
+// This binary replaces the global allocation functions to observe which
+// operator delete DefaultDeleter reaches, so it must stay a separate test target.
+namespace
+{
+    struct DeleteLog
+    {
+        bool recording = false;
+        int unsized = 0;
+        int sized = 0;
+        std::size_t lastSize = 0;
+        std::size_t lastAlign = 0;
+    };
+
+    DeleteLog deleteLog;
+
+    void record(std::size_t size, std::size_t align)
+    {
+        if (deleteLog.recording)
+        {
+            if (size == 0)
+            {
+                ++deleteLog.unsized;
+            }
+            else
+            {
+                ++deleteLog.sized;
+            }
+            deleteLog.lastSize = size;
+            deleteLog.lastAlign = align;
+        }
+    }
+
+    // Records deletes made while it is alive
+    struct Recording
+    {
+        Recording() { deleteLog = DeleteLog{true}; }
+        ~Recording() { deleteLog.recording = false; }
+    };
+}
+
+void *operator new(std::size_t n)
+{
+    if (void *p = std::malloc(n ? n : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t n, std::align_val_t align)
+{
+    const auto a = static_cast<std::size_t>(align);
+    if (void *p = std::aligned_alloc(a, (n + a - 1) / a * a))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    record(0, 0);
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t n) noexcept
+{
+    record(n, 0);
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t align) noexcept
+{
+    record(0, static_cast<std::size_t>(align));
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t n, std::align_val_t align) noexcept
+{
+    record(n, static_cast<std::size_t>(align));
+    std::free(p);
+}
+
+namespace
+{
+    struct Small
+    {
+        int m_values[5];
+    };
+
+    struct alignas(64) OverAligned
+    {
+        char m_bytes[100];
+    };
+
+    struct ClassDelete
+    {
+        static inline int deletes = 0;
+
+        static void operator delete(void *p)
+        {
+            ++deletes;
+            ::operator delete(p);
+        }
+    };
+
+    struct Destroying
+    {
+        static inline int destroyingDeletes = 0;
+
+        static void operator delete(Destroying *p, std::destroying_delete_t)
+        {
+            ++destroyingDeletes;
+            p->~Destroying();
+            ::operator delete(p);
+        }
+    };
+
+    struct Base
+    {
+        virtual ~Base() = default;
+    };
+
+    struct Derived : Base
+    {
+        double m_extra[4];
+    };
+}
+
+static_assert(detail::kSizedDelete<Small>);
+static_assert(detail::kSizedDelete<const Small>);
+static_assert(!detail::kSizedDelete<ClassDelete>);
+static_assert(!detail::kSizedDelete<Destroying>);
+static_assert(!detail::kSizedDelete<Base>);
+
+TEST(SizedDeleteTest, SmallObjectPassesSize)
+{
+    auto p = make_unique<Small>();
+
+    Recording recording;
+    p.reset();
+
+    EXPECT_EQ(deleteLog.sized, 1);
+    EXPECT_EQ(deleteLog.unsized, 0);
+    EXPECT_EQ(deleteLog.lastSize, sizeof(Small));
+}
+
+TEST(SizedDeleteTest, ConstObjectPassesSize)
+{
+    UniquePtr<const Small> p(new const Small{});
+
+    Recording recording;
+    p.reset();
+
+    EXPECT_EQ(deleteLog.sized, 1);
+    EXPECT_EQ(deleteLog.lastSize, sizeof(Small));
+}
+
+TEST(SizedDeleteTest, OverAlignedObjectPassesSizeAndAlignment)
+{
+    auto p = make_unique<OverAligned>();
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p.get()) % 64, 0u);
+
+    Recording recording;
+    p.reset();
+
+    EXPECT_EQ(deleteLog.sized, 1);
+    EXPECT_EQ(deleteLog.lastSize, sizeof(OverAligned));
+    EXPECT_EQ(deleteLog.lastAlign, 64u);
+}
+
+TEST(SizedDeleteTest, ClassOperatorDeleteIsRespected)
+{
+    ClassDelete::deletes = 0;
+    auto p = make_unique<ClassDelete>();
+
+    p.reset();
+
+    EXPECT_EQ(ClassDelete::deletes, 1);
+}
+
+TEST(SizedDeleteTest, DestroyingDeleteIsRespected)
+{
+    Destroying::destroyingDeletes = 0;
+    auto p = make_unique<Destroying>();
+
+    p.reset();
+
+    EXPECT_EQ(Destroying::destroyingDeletes, 1);
+}
+
+TEST(SizedDeleteTest, PolymorphicObjectIsNotSizedAsBase)
+{
+    UniquePtr<Base> p = make_unique<Derived>();
+
+    Recording recording;
+    p.reset();
+
+    // The deleting destructor knows the dynamic size, if the compiler passes one at all
+    EXPECT_EQ(deleteLog.sized + deleteLog.unsized, 1);
+    EXPECT_NE(deleteLog.lastSize, sizeof(Base));
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "atomic_unique.hpp"
+#include "thread_cache.hpp"
+
+namespace
+{
+    struct Job
+    {
+        static inline std::atomic<int> alive{0};
+
+        int id;
+
+        explicit Job(int i) : id(i) { ++alive; }
+        ~Job() { --alive; }
+    };
+
+    using CachedPtr = UniquePtr<Job, CachedDeleter<Job>>;
+
+    // Constructed before the thread's cache, so destroyed after it
+    struct LateOwner
+    {
+        CachedPtr m_job;
+    };
+}
+
+TEST(ThreadCacheTest, CachedPointerIsPointerSized)
+{
+    EXPECT_EQ(sizeof(CachedPtr), sizeof(Job *));
+}
+
+TEST(ThreadCacheTest, SameThreadFreeIsReused)
+{
+    Job *first = nullptr;
+    {
+        auto job = make_unique_cached<Job>(1);
+        first = job.get();
+    }
+    EXPECT_EQ(Job::alive, 0);
+
+    auto again = make_unique_cached<Job>(2);
+    EXPECT_EQ(again.get(), first);
+    EXPECT_EQ(again->id, 2);
+}
+
+TEST(ThreadCacheTest, RemoteFreeReturnsToOwner)
+{
+    auto job = make_unique_cached<Job>(1);
+    Job *block = job.get();
+
+    std::thread consumer([moved = std::move(job)]() mutable
+                         { moved.reset(); });
+    consumer.join();
+    EXPECT_EQ(Job::alive, 0);
+
+    // Drain the local list so the next allocation pulls from the remote list
+    std::vector<CachedPtr> jobs;
+    bool reused = false;
+    for (std::size_t i = 0; i <= ThreadCache<Job>::kLocalCapacity && !reused; ++i)
+    {
+        jobs.push_back(make_unique_cached<Job>(static_cast<int>(i)));
+        reused = jobs.back().get() == block;
+    }
+    EXPECT_EQ(reused, true);
+}
+
+TEST(ThreadCacheTest, OwnerThreadExitsBeforeFree)
+{
+    CachedPtr job;
+
+    std::thread producer([&]
+                         { job = make_unique_cached<Job>(7); });
+    producer.join();
+
+    EXPECT_EQ(job->id, 7);
+    job.reset();
+    EXPECT_EQ(Job::alive, 0);
+}
+
+TEST(ThreadCacheTest, ProducerConsumerPipeline)
+{
+    constexpr int count = 2000;
+    AtomicUniquePtr<Job, CachedDeleter<Job>> slot;
+    std::atomic<long> sum{0};
+
+    std::thread consumer([&]
+                         {
+        int seen = 0;
+        while (seen < count)
+        {
+            if (auto job = slot.take())
+            {
+                sum += job->id;
+                ++seen;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    std::thread producer([&]
+                         {
+        for (int i = 1; i <= count; ++i)
+        {
+            auto job = make_unique_cached<Job>(i);
+            Job *expected = nullptr;
+            while (!slot.compare_exchange(expected, job))
+            {
+                expected = nullptr;
+                std::this_thread::yield();
+            }
+        } });
+
+    producer.join();
+    consumer.join();
+
+    EXPECT_EQ(sum, static_cast<long>(count) * (count + 1) / 2);
+    EXPECT_EQ(Job::alive, 0);
+}
+
+TEST(ThreadCacheTest, FreeAfterOwnCacheIsDestroyed)
+{
+    std::thread worker([]
+                       {
+        thread_local LateOwner owner;
+        owner.m_job = make_unique_cached<Job>(1); });
+    worker.join();
+
+    EXPECT_EQ(Job::alive, 0);
+}
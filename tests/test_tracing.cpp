@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tracing.hpp"
+
+namespace
+{
+    struct Session
+    {
+        static inline int alive = 0;
+
+        Session() { ++alive; }
+        virtual ~Session() { --alive; }
+    };
+
+    struct TlsSession : Session
+    {
+    };
+
+    std::vector<TraceEvent> events(const TraceBuffer &buffer)
+    {
+        std::vector<TraceEvent> result;
+        buffer.forEach([&](const TraceEvent &e) { result.push_back(e); });
+        return result;
+    }
+
+    // Events recorded into the global buffer by the current test
+    std::vector<TraceEvent> eventsSince(std::uint64_t start)
+    {
+        std::vector<TraceEvent> result;
+        std::uint64_t index = 0;
+        TraceBuffer::instance().forEach([&](const TraceEvent &e)
+                                        {
+                                            if (index++ >= start)
+                                            {
+                                                result.push_back(e);
+                                            }
+                                        });
+        return result;
+    }
+}
+
+TEST(TracingTest, DestructionIsRecorded)
+{
+    const std::uint64_t start = TraceBuffer::instance().recorded();
+    const void *address = nullptr;
+    {
+        auto session = make_traced_unique<Session>();
+        address = session.get();
+    }
+
+    EXPECT_EQ(Session::alive, 0);
+
+    const auto recorded = eventsSince(start);
+    ASSERT_EQ(recorded.size(), 1u);
+    EXPECT_NE(recorded[0].type.find("Session"), std::string_view::npos);
+    EXPECT_EQ(recorded[0].object, reinterpret_cast<std::uintptr_t>(address));
+    EXPECT_LE(recorded[0].born, recorded[0].freeBegin);
+    EXPECT_LE(recorded[0].freeBegin, recorded[0].freeEnd);
+    EXPECT_EQ(recorded[0].thread, TraceBuffer::threadId());
+    EXPECT_EQ(recorded[0].bornThread, TraceBuffer::threadId());
+}
+
+TEST(TracingTest, ResetIsRecorded)
+{
+    const std::uint64_t start = TraceBuffer::instance().recorded();
+    auto session = make_traced_unique<Session>();
+
+    session.reset(new Session());
+    session.reset();
+
+    // The replacement's lifetime starts when reset() adopts it, after the first object is gone
+    const auto recorded = eventsSince(start);
+    ASSERT_EQ(recorded.size(), 2u);
+    EXPECT_LE(recorded[0].born, recorded[0].freeBegin);
+    EXPECT_GE(recorded[1].born, recorded[0].freeEnd);
+    EXPECT_LE(recorded[1].born, recorded[1].freeBegin);
+}
+
+TEST(TracingTest, RecordsAdoptingAndFreeingThreads)
+{
+    const std::uint64_t start = TraceBuffer::instance().recorded();
+    auto session = make_traced_unique<Session>();
+
+    std::uint32_t freeingThread = 0;
+    std::thread worker([&freeingThread, moved = std::move(session)]() mutable
+                       {
+        freeingThread = TraceBuffer::threadId();
+        moved.reset(); });
+    worker.join();
+
+    const auto recorded = eventsSince(start);
+    ASSERT_EQ(recorded.size(), 1u);
+    EXPECT_EQ(recorded[0].bornThread, TraceBuffer::threadId());
+    EXPECT_EQ(recorded[0].thread, freeingThread);
+    EXPECT_NE(recorded[0].bornThread, recorded[0].thread);
+}
+
+TEST(TracingTest, WrapsAnyDeleterAndFollowsConversions)
+{
+    const std::uint64_t start = TraceBuffer::instance().recorded();
+    {
+        UniquePtr<TlsSession, TracingDeleter<DefaultDeleter<TlsSession>>> derived(new TlsSession());
+        UniquePtr<Session, TracingDeleter<DefaultDeleter<Session>>> base(std::move(derived));
+    }
+
+    const auto recorded = eventsSince(start);
+    ASSERT_EQ(recorded.size(), 1u);
+    EXPECT_EQ(Session::alive, 0);
+}
+
+TEST(TracingTest, ArraysRecordAdoption)
+{
+    const std::uint64_t start = TraceBuffer::instance().recorded();
+    {
+        UniquePtr<int[], TracingDeleter<DefaultDeleter<int[]>>> values(new int[4]());
+        values.reset(new int[8]());
+    }
+
+    const auto recorded = eventsSince(start);
+    ASSERT_EQ(recorded.size(), 2u);
+    EXPECT_NE(recorded[0].born, 0u);
+    EXPECT_EQ(recorded[0].bornThread, TraceBuffer::threadId());
+    EXPECT_GE(recorded[1].born, recorded[0].freeEnd);
+    EXPECT_EQ(recorded[1].bornThread, TraceBuffer::threadId());
+}
+
+TEST(TracingTest, RingKeepsNewestEvents)
+{
+    static constexpr std::string_view kType = "Fake";
+    TraceBuffer buffer(6);
+    EXPECT_EQ(buffer.capacity(), 8u);
+
+    for (std::uint64_t i = 0; i < 20; ++i)
+    {
+        buffer.record(&kType, nullptr, i, 1, i, i);
+    }
+
+    const auto kept = events(buffer);
+    ASSERT_EQ(kept.size(), 8u);
+    EXPECT_EQ(kept.front().born, 12u);
+    EXPECT_EQ(kept.back().born, 19u);
+    EXPECT_EQ(buffer.recorded(), 20u);
+}
+
+TEST(TracingTest, ConcurrentWritersLoseNothingBelowCapacity)
+{
+    static constexpr std::string_view kType = "Fake";
+    TraceBuffer buffer(1024);
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t)
+    {
+        writers.emplace_back([&buffer]
+                             {
+                                 for (int i = 0; i < 200; ++i)
+                                 {
+                                     buffer.record(&kType, nullptr, 0, 1, 0, 0);
+                                 }
+                             });
+    }
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    EXPECT_EQ(events(buffer).size(), 800u);
+}
+
+TEST(TracingTest, WritesChromeTraceJson)
+{
+    static constexpr std::string_view kType = "Order";
+    TraceBuffer buffer(4);
+    buffer.record(&kType, reinterpret_cast<void *>(0x10), 1000, 2, 5000, 7000);
+
+    std::ostringstream out;
+    buffer.writeChromeTrace(out);
+    const std::string json = out.str();
+
+    EXPECT_EQ(json.rfind("{\"traceEvents\": [", 0), 0u);
+    EXPECT_NE(json.find("\"name\": \"Order\", \"cat\": \"lifetime\", \"ph\": \"b\", \"id\": \"0x10\", \"pid\": 1, \"tid\": 2"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"~Order\", \"cat\": \"destroy\", \"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\": 5, \"dur\": 2}"), std::string::npos);
+}
+
+TEST(TracingTest, DumpsToFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "unique_ptr_trace_test.json";
+    {
+        auto session = make_traced_unique<Session>();
+    }
+
+    TraceBuffer::instance().writeChromeTrace(path);
+
+    std::ifstream in(path);
+    const std::string json((std::istreambuf_iterator<char>(in)), {});
+    std::filesystem::remove(path);
+
+    EXPECT_NE(json.find("\"cat\": \"destroy\""), std::string::npos);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include "unique_array.hpp"
+
+static_assert(std::ranges::contiguous_range<UniqueArray<int>>);
+static_assert(std::ranges::sized_range<UniqueArray<int>>);
+
+TEST(UniqueArrayTest, MakeUniqueArrayKeepsSize)
+{
+    auto a = make_unique_array<int>(8);
+
+    EXPECT_EQ(a.size(), 8u);
+    EXPECT_EQ(a.empty(), false);
+    EXPECT_EQ(a.end() - a.begin(), 8);
+}
+
+TEST(UniqueArrayTest, DefaultConstructedIsEmpty)
+{
+    UniqueArray<int> a;
+
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(a.empty(), true);
+    EXPECT_EQ(static_cast<bool>(a), false);
+    EXPECT_EQ(a.begin(), a.end());
+}
+
+TEST(UniqueArrayTest, RangeAlgorithms)
+{
+    auto a = make_unique_array<int>(5);
+    std::iota(a.begin(), a.end(), 0);
+    std::ranges::reverse(a);
+
+    EXPECT_EQ(a[0], 4);
+    EXPECT_EQ(a[4], 0);
+
+    int sum = 0;
+    for (int v : a)
+    {
+        sum += v;
+    }
+    EXPECT_EQ(sum, 10);
+}
+
+TEST(UniqueArrayTest, IteratorAlgorithms)
+{
+    auto a = make_unique_array<int>(1000);
+    std::ranges::fill(a, 2);
+
+    EXPECT_EQ(std::reduce(a.begin(), a.end()), 2000);
+}
+
+TEST(UniqueArrayTest, AsSpan)
+{
+    auto a = make_unique_array<int>(3);
+    std::span<int> s = a.as_span();
+    s[1] = 42;
+
+    EXPECT_EQ(s.size(), 3u);
+    EXPECT_EQ(a[1], 42);
+
+    const auto &ca = a;
+    std::span<const int> cs = ca.as_span();
+    EXPECT_EQ(cs.data(), a.data());
+}
+
+TEST(UniqueArrayTest, MoveTransfersSize)
+{
+    auto a = make_unique_array<int>(4);
+    int *data = a.data();
+
+    UniqueArray<int> b(std::move(a));
+    EXPECT_EQ(b.data(), data);
+    EXPECT_EQ(b.size(), 4u);
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(a.data(), nullptr);
+
+    UniqueArray<int> c;
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 4u);
+    EXPECT_EQ(b.size(), 0u);
+}
+
+TEST(UniqueArrayTest, AdoptUniquePtr)
+{
+    UniqueArray<int> a(UniquePtr<int[]>(new int[3]{1, 2, 3}), 3);
+
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(a[2], 3);
+}
+
+TEST(UniqueArrayTest, ReleaseAndReset)
+{
+    auto a = make_unique_array<int>(2);
+    int *raw = a.release();
+
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(a.data(), nullptr);
+
+    a.reset(raw, 2);
+    EXPECT_EQ(a.size(), 2u);
+
+    a.reset();
+    EXPECT_EQ(a.empty(), true);
+}
+
+TEST(UniqueArrayTest, Swap)
+{
+    auto a = make_unique_array<int>(1);
+    auto b = make_unique_array<int>(3);
+
+    swap(a, b);
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_EQ(b.size(), 1u);
+}
+
+#ifndef NDEBUG
+TEST(UniqueArrayDeathTest, OutOfRangeIndexAssertsInDebug)
+{
+    auto a = make_unique_array<int>(2);
+    EXPECT_DEATH((void)a[2], "out of range");
+}
+#endif
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#include "relocate.hpp"
+#include "unique_handle.hpp"
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#endif
+
+namespace
+{
+    // Handles are small ints with 0 as the sentinel; closing records the handle
+    struct SlotTraits
+    {
+        using Handle = int;
+
+        static inline std::vector<int> closed;
+
+        static constexpr int invalid() noexcept { return 0; }
+
+        void close(int h) const noexcept { closed.push_back(h); }
+    };
+
+    using Slot = UniqueHandle<SlotTraits>;
+
+    // Stateful traits that close into a caller-provided log
+    struct LoggingTraits
+    {
+        using Handle = long;
+
+        std::vector<long> *m_log = nullptr;
+
+        static constexpr long invalid() noexcept { return -1; }
+
+        void close(long h) const noexcept { m_log->push_back(h); }
+    };
+
+    // Written against UniquePtr's surface only
+    template <typename Owner>
+    auto handOver(Owner &from, Owner &to)
+    {
+        auto deleter = from.getDeleter();
+        to.reset(from.release());
+        swap(from, to);
+        return deleter;
+    }
+
+    class UniqueHandleTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override { SlotTraits::closed.clear(); }
+    };
+}
+
+static_assert(sizeof(Slot) == sizeof(int));
+static_assert(is_trivially_relocatable_v<Slot>);
+static_assert(!std::is_copy_constructible_v<Slot>);
+
+TEST_F(UniqueHandleTest, DefaultHoldsSentinel)
+{
+    Slot slot;
+
+    EXPECT_EQ(slot.get(), 0);
+    EXPECT_EQ(static_cast<bool>(slot), false);
+}
+
+TEST_F(UniqueHandleTest, ClosesOnDestruction)
+{
+    {
+        Slot slot(7);
+        EXPECT_EQ(static_cast<bool>(slot), true);
+    }
+
+    EXPECT_EQ(SlotTraits::closed, std::vector<int>{7});
+}
+
+TEST_F(UniqueHandleTest, ReleaseGivesUpOwnership)
+{
+    {
+        Slot slot(3);
+        EXPECT_EQ(slot.release(), 3);
+        EXPECT_EQ(static_cast<bool>(slot), false);
+    }
+
+    EXPECT_EQ(SlotTraits::closed.empty(), true);
+}
+
+TEST_F(UniqueHandleTest, ResetClosesPreviousHandle)
+{
+    Slot slot(1);
+
+    slot.reset(2);
+    EXPECT_EQ(SlotTraits::closed, std::vector<int>{1});
+
+    slot.reset(2);
+    EXPECT_EQ(SlotTraits::closed, std::vector<int>{1});
+
+    slot.reset();
+    EXPECT_EQ(SlotTraits::closed, (std::vector<int>{1, 2}));
+}
+
+TEST_F(UniqueHandleTest, MoveTransfersOwnership)
+{
+    Slot a(4);
+    Slot b(std::move(a));
+
+    EXPECT_EQ(static_cast<bool>(a), false);
+    EXPECT_EQ(b.get(), 4);
+
+    Slot c(5);
+    c = std::move(b);
+
+    EXPECT_EQ(c.get(), 4);
+    EXPECT_EQ(SlotTraits::closed, std::vector<int>{5});
+}
+
+TEST_F(UniqueHandleTest, SwapExchangesHandles)
+{
+    Slot a(1);
+    Slot b(2);
+
+    swap(a, b);
+
+    EXPECT_EQ(a.get(), 2);
+    EXPECT_EQ(b.get(), 1);
+    EXPECT_NE(a, b);
+}
+
+TEST_F(UniqueHandleTest, StatefulTraitsTravelWithHandle)
+{
+    std::vector<long> log;
+    {
+        UniqueHandle<LoggingTraits> a(10, LoggingTraits{&log});
+        UniqueHandle<LoggingTraits> b(std::move(a));
+        EXPECT_EQ(b.getTraits().m_log, &log);
+    }
+
+    EXPECT_EQ(log, std::vector<long>{10});
+}
+
+TEST_F(UniqueHandleTest, GenericOwnerCodeAccepts)
+{
+    std::vector<long> log;
+    {
+        UniqueHandle<LoggingTraits> a(10, LoggingTraits{&log});
+        UniqueHandle<LoggingTraits> b(20, LoggingTraits{&log});
+
+        EXPECT_EQ(handOver(a, b).m_log, &log);
+        EXPECT_EQ(a.get(), 10);
+        EXPECT_EQ(static_cast<bool>(b), false);
+        EXPECT_EQ(log, std::vector<long>{20});
+    }
+
+    EXPECT_EQ(log, (std::vector<long>{20, 10}));
+
+    UniquePtr<int> p(new int(1));
+    UniquePtr<int> q;
+    handOver(p, q);
+    EXPECT_EQ(*p, 1);
+}
+
+TEST_F(UniqueHandleTest, StoredByValueInContainers)
+{
+    {
+        RelocatingVector<Slot> slots;
+        for (int i = 1; i <= 100; ++i)
+        {
+            slots.emplace_back(i);
+        }
+        EXPECT_EQ(slots[99].get(), 100);
+        EXPECT_EQ(SlotTraits::closed.empty(), true);
+    }
+
+    EXPECT_EQ(SlotTraits::closed.size(), 100u);
+}
+
+#if __has_include(<unistd.h>)
+TEST(UniqueFdTest, ClosesDescriptor)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    UniqueFd writeEnd(fds[1]);
+    {
+        UniqueFd readEnd(fds[0]);
+        EXPECT_NE(::fcntl(fds[0], F_GETFD), -1);
+    }
+
+    EXPECT_EQ(::fcntl(fds[0], F_GETFD), -1);
+    EXPECT_NE(::fcntl(writeEnd.get(), F_GETFD), -1);
+}
+
+TEST(UniqueFdTest, FailedOpenIsEmpty)
+{
+    UniqueFd fd(::open("/nonexistent/unique_handle", O_RDONLY));
+
+    EXPECT_EQ(static_cast<bool>(fd), false);
+}
+#endif
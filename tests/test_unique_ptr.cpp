@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
 #include "unique.hpp"
 
 TEST(UniquePtrTest, CreateAndAccessTest)
@@ -188,4 +190,330 @@ TEST(UniquePtrTest, CustomDeleterArray)
     }
 
     EXPECT_EQ(deleter_called, true);
-}
\ No newline at end of file
+}
+
+TEST(UniquePtrTest, MakeUniqueForOverwriteScalar)
+{
+    struct Counter
+    {
+        int calls = 7;
+    };
+
+    auto value = make_unique_for_overwrite<int>();
+    *value = 42;
+    EXPECT_EQ(*value, 42);
+
+    // Class types still run their default constructor
+    auto counter = make_unique_for_overwrite<Counter>();
+    EXPECT_EQ(counter->calls, 7);
+}
+
+TEST(UniquePtrTest, MakeUniqueForOverwriteArray)
+{
+    constexpr size_t size = 1 << 20;
+    auto buffer = make_unique_for_overwrite<unsigned char[]>(size);
+
+    EXPECT_EQ(buffer != nullptr, true);
+    for (size_t i = 0; i < size; ++i)
+    {
+        buffer[i] = static_cast<unsigned char>(i);
+    }
+    EXPECT_EQ(buffer[size - 1], static_cast<unsigned char>(size - 1));
+}
+
+namespace
+{
+    struct Handler
+    {
+        static inline int alive = 0;
+
+        Handler() { ++alive; }
+        Handler(const Handler &) { ++alive; }
+        Handler(Handler &&) noexcept { ++alive; }
+        virtual ~Handler() { --alive; }
+        virtual int handle() const = 0;
+    };
+
+    struct SmallHandler : Handler
+    {
+        int value;
+        explicit SmallHandler(int v) : value(v) {}
+        int handle() const override { return value; }
+    };
+
+    struct LargeHandler : Handler
+    {
+        char payload[256] = {};
+        int value;
+        explicit LargeHandler(int v) : value(v) {}
+        int handle() const override { return value * 2; }
+    };
+}
+
+TEST(InlineUniquePtrTest, SmallObjectIsStoredInline)
+{
+    {
+        auto p = make_inline_unique<Handler, SmallHandler>(7);
+
+        EXPECT_EQ(p.isInline(), true);
+        EXPECT_EQ(p->handle(), 7);
+        EXPECT_EQ(Handler::alive, 1);
+    }
+
+    EXPECT_EQ(Handler::alive, 0);
+}
+
+TEST(InlineUniquePtrTest, LargeObjectFallsBackToHeap)
+{
+    {
+        auto p = make_inline_unique<Handler, LargeHandler>(5);
+
+        EXPECT_EQ(p.isInline(), false);
+        EXPECT_EQ(p->handle(), 10);
+    }
+
+    EXPECT_EQ(Handler::alive, 0);
+}
+
+TEST(InlineUniquePtrTest, MoveRelocatesInlineObject)
+{
+    auto a = make_inline_unique<Handler, SmallHandler>(3);
+    InlineUniquePtr<Handler> b(std::move(a));
+
+    EXPECT_EQ(a == nullptr, true);
+    EXPECT_EQ(b.isInline(), true);
+    EXPECT_EQ(b->handle(), 3);
+    EXPECT_EQ(Handler::alive, 1);
+
+    InlineUniquePtr<Handler> c;
+    c = std::move(b);
+    EXPECT_EQ(b == nullptr, true);
+    EXPECT_EQ(c->handle(), 3);
+    EXPECT_EQ(Handler::alive, 1);
+}
+
+TEST(InlineUniquePtrTest, MoveKeepsHeapObjectAddress)
+{
+    auto a = make_inline_unique<Handler, LargeHandler>(4);
+    Handler *object = a.get();
+
+    InlineUniquePtr<Handler> b(std::move(a));
+    EXPECT_EQ(b.get(), object);
+    EXPECT_EQ(Handler::alive, 1);
+}
+
+TEST(InlineUniquePtrTest, EmplaceReplacesAndReset)
+{
+    InlineUniquePtr<Handler> p;
+    EXPECT_EQ(p == nullptr, true);
+
+    p.emplace<SmallHandler>(1);
+    p.emplace<LargeHandler>(2);
+    EXPECT_EQ(p->handle(), 4);
+    EXPECT_EQ(Handler::alive, 1);
+
+    p.reset();
+    EXPECT_EQ(p == nullptr, true);
+    EXPECT_EQ(Handler::alive, 0);
+}
+
+TEST(InlineUniquePtrTest, SwapMixedStorage)
+{
+    auto a = make_inline_unique<Handler, SmallHandler>(1);
+    auto b = make_inline_unique<Handler, LargeHandler>(2);
+
+    swap(a, b);
+    EXPECT_EQ(a->handle(), 4);
+    EXPECT_EQ(b->handle(), 1);
+    EXPECT_EQ(b.isInline(), true);
+    EXPECT_EQ(Handler::alive, 2);
+}
+
+TEST(InlineUniquePtrTest, VectorGrowthKeepsObjectsValid)
+{
+    {
+        std::vector<InlineUniquePtr<Handler>> handlers;
+        for (int i = 0; i < 100; ++i)
+        {
+            handlers.push_back(make_inline_unique<Handler, SmallHandler>(i));
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(handlers[i]->handle(), i);
+        }
+        EXPECT_EQ(Handler::alive, 100);
+    }
+
+    EXPECT_EQ(Handler::alive, 0);
+}
+
+namespace
+{
+    struct CHandle
+    {
+        int m_value;
+    };
+
+    int destroyedHandles = 0;
+
+    // Stands in for a C library's destroy function
+    void destroy_handle(CHandle *h)
+    {
+        ++destroyedHandles;
+        delete h;
+    }
+}
+
+static_assert(sizeof(UniquePtr<std::FILE, FnDeleter<&fclose>>) == sizeof(std::FILE *));
+static_assert(sizeof(UniquePtr<CHandle, FnDeleter<&destroy_handle>>) == sizeof(CHandle *));
+static_assert(sizeof(UniquePtr<CHandle, void (*)(CHandle *)>) == 2 * sizeof(CHandle *));
+
+TEST(FnDeleterTest, ClosesFile)
+{
+    UniquePtr<std::FILE, FnDeleter<&fclose>> file(std::tmpfile());
+    ASSERT_NE(file.get(), nullptr);
+
+    EXPECT_GE(std::fputs("owned", file.get()), 0);
+    file.reset();
+
+    EXPECT_EQ(file.get(), nullptr);
+}
+
+TEST(FnDeleterTest, CallsDestroyFunctionOnce)
+{
+    destroyedHandles = 0;
+    {
+        UniquePtr<CHandle, FnDeleter<&destroy_handle>> a(new CHandle{1});
+        UniquePtr<CHandle, FnDeleter<&destroy_handle>> b(std::move(a));
+
+        EXPECT_EQ(b->m_value, 1);
+        EXPECT_EQ(destroyedHandles, 0);
+    }
+
+    EXPECT_EQ(destroyedHandles, 1);
+}
+
+namespace
+{
+    struct Shape
+    {
+        static inline int alive = 0;
+
+        Shape() { ++alive; }
+        virtual ~Shape() { --alive; }
+        virtual int sides() const noexcept = 0;
+    };
+
+    struct Square final : Shape
+    {
+        int sides() const noexcept override { return 4; }
+    };
+
+    struct Triangle final : Shape
+    {
+        int sides() const noexcept override { return 3; }
+    };
+}
+
+static_assert(std::is_constructible_v<UniquePtr<Shape>, UniquePtr<Square> &&>);
+static_assert(!std::is_constructible_v<UniquePtr<Square>, UniquePtr<Shape> &&>);
+static_assert(!std::is_constructible_v<UniquePtr<Shape>, UniquePtr<Square> &>);
+static_assert(!std::is_constructible_v<UniquePtr<Shape>, UniquePtr<Square[]> &&>);
+
+TEST(ConvertingMoveTest, DerivedMovesIntoBase)
+{
+    {
+        UniquePtr<Square> square = make_unique<Square>();
+        Square *raw = square.get();
+
+        UniquePtr<Shape> shape(std::move(square));
+
+        EXPECT_EQ(square, nullptr);
+        EXPECT_EQ(shape.get(), raw);
+        EXPECT_EQ(shape->sides(), 4);
+    }
+
+    EXPECT_EQ(Shape::alive, 0);
+}
+
+TEST(ConvertingMoveTest, AssignmentDestroysPreviousObject)
+{
+    UniquePtr<Shape> shape = make_unique<Square>();
+    shape = make_unique<Triangle>();
+
+    EXPECT_EQ(Shape::alive, 1);
+    EXPECT_EQ(shape->sides(), 3);
+}
+
+TEST(ConvertingMoveTest, HeterogeneousContainer)
+{
+    {
+        std::vector<UniquePtr<Shape>> shapes;
+        shapes.push_back(make_unique<Square>());
+        shapes.push_back(make_unique<Triangle>());
+
+        int total = 0;
+        for (const auto &shape : shapes)
+        {
+            total += shape->sides();
+        }
+        EXPECT_EQ(total, 7);
+    }
+
+    EXPECT_EQ(Shape::alive, 0);
+}
+
+TEST(UniqueCastTest, StaticCastTransfersOwnership)
+{
+    UniquePtr<Shape> shape = make_unique<Square>();
+    Shape *raw = shape.get();
+
+    UniquePtr<Square> square = static_unique_cast<Square>(std::move(shape));
+
+    EXPECT_EQ(shape, nullptr);
+    EXPECT_EQ(square.get(), raw);
+}
+
+TEST(UniqueCastTest, DynamicCastSuccessTransfersOwnership)
+{
+    UniquePtr<Shape> shape = make_unique<Triangle>();
+
+    UniquePtr<Triangle> triangle = dynamic_unique_cast<Triangle>(std::move(shape));
+
+    EXPECT_EQ(shape, nullptr);
+    ASSERT_NE(triangle, nullptr);
+    EXPECT_EQ(triangle->sides(), 3);
+}
+
+TEST(UniqueCastTest, DynamicCastFailureKeepsSourceOwning)
+{
+    UniquePtr<Shape> shape = make_unique<Triangle>();
+
+    UniquePtr<Square> square = dynamic_unique_cast<Square>(std::move(shape));
+
+    EXPECT_EQ(square, nullptr);
+    ASSERT_NE(shape, nullptr);
+    EXPECT_EQ(shape->sides(), 3);
+    EXPECT_EQ(Shape::alive, 1);
+}
+
+TEST(UniqueCastTest, CustomDeleterIsCarriedOver)
+{
+    int deleted = 0;
+    auto deleter = [&deleted](Shape *p)
+    {
+        ++deleted;
+        delete p;
+    };
+
+    {
+        UniquePtr<Shape, decltype(deleter)> shape(new Square(), deleter);
+        auto square = static_unique_cast<Square>(std::move(shape));
+
+        static_assert(std::is_same_v<decltype(square), UniquePtr<Square, decltype(deleter)>>);
+        EXPECT_EQ(deleted, 0);
+    }
+
+    EXPECT_EQ(deleted, 1);
+}